@@ -0,0 +1,371 @@
+/*
+  ==============================================================================
+
+    InstanceBenchmark.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "InstanceBenchmark.h"
+#include "../../Source/OutputMeter.h"
+
+#if JUCE_LINUX || JUCE_ANDROID
+ #include <unistd.h>
+#elif JUCE_MAC
+ #include <mach/mach.h>
+#elif JUCE_WINDOWS
+ #include <windows.h>
+ #include <psapi.h>
+ #pragma comment (lib, "psapi.lib")
+#endif
+
+juce::int64 getResidentBytes()
+{
+   #if JUCE_LINUX || JUCE_ANDROID
+    //second field of statm is the resident page count.
+    auto fields = juce::StringArray::fromTokens(juce::File("/proc/self/statm").loadFileAsString(), true);
+
+    if (fields.size() < 2)
+        return -1;
+
+    return fields[1].getLargeIntValue() * static_cast<juce::int64>(sysconf(_SC_PAGESIZE));
+   #elif JUCE_MAC
+    mach_task_basic_info info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS)
+        return -1;
+
+    return static_cast<juce::int64>(info.resident_size);
+   #elif JUCE_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if (! GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return -1;
+
+    return static_cast<juce::int64>(counters.WorkingSetSize);
+   #else
+    return -1;
+   #endif
+}
+
+namespace
+{
+    //one slow sine per automated parameter, in normalised parameter space.
+    struct Automation
+    {
+        juce::RangedAudioParameter* parameter { nullptr };
+        float centre { 0.5f }, depth { 0.f };
+        double phase { 0.0 }, phaseIncrement { 0.0 };
+
+        void advance()
+        {
+            parameter->setValueNotifyingHost(juce::jlimit(0.f, 1.f, centre + depth * static_cast<float>(std::sin(phase))));
+            phase += phaseIncrement;
+        }
+    };
+
+    struct Instance
+    {
+        std::unique_ptr<RuckusEQAudioProcessor> processor;
+        juce::AudioBuffer<float> buffer;
+        std::vector<Automation> automation;
+
+        //processBlock time of every measured block, in microseconds.
+        std::vector<float> times;
+    };
+
+    //settings a mix engineer might plausibly leave on a track: gains mostly within +/-12 dB, moderate Qs, most bands in use, cuts in the lower and upper halves of their ranges.
+    void randomiseParameters(RuckusEQAudioProcessor& processor, const BenchmarkConfig& config, juce::Random& random)
+    {
+        auto set = [](juce::RangedAudioParameter& parameter, float normalisedValue)
+        {
+            parameter.setValueNotifyingHost(juce::jlimit(0.f, 1.f, normalisedValue));
+        };
+
+        for (auto* p : processor.getParameters())
+        {
+            auto* parameter = dynamic_cast<juce::RangedAudioParameter*>(p);
+
+            if (parameter == nullptr)
+                continue;
+
+            auto id = parameter->getParameterID();
+
+            if (id == "Filter Topology")
+                set(*parameter, static_cast<float>(config.topology >= 0 ? config.topology : random.nextInt(2)));
+            else if (id == "Coefficient Design")
+                set(*parameter, static_cast<float>(config.design >= 0 ? config.design : random.nextInt(2)));
+            else if (id == "HighPass Freq")
+                set(*parameter, random.nextFloat() * 0.5f);
+            else if (id == "LowPass Freq")
+                set(*parameter, 0.5f + random.nextFloat() * 0.5f);
+            else if (id.endsWith(" Slope"))
+                set(*parameter, parameter->convertTo0to1(static_cast<float>(random.nextInt(4))));
+            else if (id.endsWith(" On"))
+                set(*parameter, random.nextFloat() < 0.85f ? 1.f : 0.f);
+            else if (id.endsWith(" Gain"))
+                set(*parameter, parameter->convertTo0to1((random.nextFloat() + random.nextFloat() + random.nextFloat() - 1.5f) * 8.f));
+            else if (id.endsWith(" Q"))
+                set(*parameter, 0.1f + random.nextFloat() * 0.4f);
+            else if (id.endsWith(" Freq"))
+                set(*parameter, random.nextFloat());
+        }
+    }
+
+    std::vector<Automation> makeAutomation(RuckusEQAudioProcessor& processor, const BenchmarkConfig& config, juce::Random& random)
+    {
+        juce::Array<juce::RangedAudioParameter*> candidates;
+
+        //the side set only runs in mid/side mode, which the benchmark leaves off. automating it would change nothing the instances process.
+        for (auto* p : processor.getParameters())
+            if (auto* parameter = dynamic_cast<juce::RangedAudioParameter*>(p))
+            {
+                auto id = parameter->getParameterID();
+
+                if ((id.endsWith(" Freq") || id.endsWith(" Gain")) && ! id.startsWith(sideParameterPrefix))
+                    candidates.add(parameter);
+            }
+
+        std::vector<Automation> automation;
+        auto blockSeconds = config.blockSize / config.sampleRate;
+
+        for (int i = 0; i < config.numAutomatedParameters && ! candidates.isEmpty(); ++i)
+        {
+            Automation a;
+            a.parameter = candidates.removeAndReturn(random.nextInt(candidates.size()));
+            a.centre = a.parameter->getValue();
+            a.depth = 0.05f + random.nextFloat() * 0.25f;
+            a.phase = random.nextDouble() * juce::MathConstants<double>::twoPi;
+
+            //0.05 Hz to 2 Hz, from slow filter sweeps to fast wobbles.
+            a.phaseIncrement = juce::MathConstants<double>::twoPi * (0.05 + random.nextDouble() * 1.95) * blockSeconds;
+
+            automation.push_back(a);
+        }
+
+        return automation;
+    }
+
+    double getPercentile(std::vector<float> values, double percentile)
+    {
+        if (values.empty())
+            return 0.0;
+
+        auto index = juce::jmin(values.size() - 1, static_cast<size_t>(percentile * static_cast<double>(values.size())));
+        std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+        return values[index];
+    }
+}
+
+BenchmarkResult runInstanceBenchmark(const BenchmarkConfig& config)
+{
+    BenchmarkResult result;
+    result.config = config;
+
+    juce::Random random(config.seed);
+
+    auto blockSeconds = config.blockSize / config.sampleRate;
+    auto numBlocks = juce::jmax(2, juce::roundToInt(config.seconds / blockSeconds));
+    auto numWarmUpBlocks = juce::jmin(numBlocks / 2, juce::roundToInt(1.0 / blockSeconds));
+    auto numMeasuredBlocks = numBlocks - numWarmUpBlocks;
+
+    //one second of noise per channel, each instance reads it from its own offset so the instances don't all see the same data.
+    auto sourceLength = juce::jmax(config.blockSize, static_cast<int>(config.sampleRate));
+    juce::AudioBuffer<float> source(config.numChannels, sourceLength);
+
+    for (int channel = 0; channel < config.numChannels; ++channel)
+        for (int i = 0; i < sourceLength; ++i)
+            source.setSample(channel, i, (random.nextFloat() * 2.f - 1.f) * 0.25f);
+
+    //the harness's own per-instance buffers are allocated and touched before the first memory reading, so the difference only counts what the processors hold.
+    std::vector<Instance> instances(static_cast<size_t>(config.numInstances));
+
+    for (auto& instance : instances)
+    {
+        instance.buffer.setSize(config.numChannels, config.blockSize);
+        instance.buffer.clear();
+        instance.times.resize(static_cast<size_t>(numMeasuredBlocks));
+    }
+
+    //every instance shares this pool, holding it here keeps the thread count set for the whole run.
+    juce::SharedResourcePointer<ChannelThreadPool> threads;
+    threads->setNumThreads(config.numThreads);
+    result.config.numThreads = threads->getNumThreads();
+
+    auto residentBefore = getResidentBytes();
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(juce::AudioChannelSet::canonicalChannelSet(config.numChannels));
+    layout.outputBuses.add(juce::AudioChannelSet::canonicalChannelSet(config.numChannels));
+
+    double constructSeconds = 0.0, prepareSeconds = 0.0;
+
+    for (auto& instance : instances)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        instance.processor = std::make_unique<RuckusEQAudioProcessor>();
+        constructSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        auto& processor = *instance.processor;
+
+        if (! processor.setBusesLayout(layout))
+            jassertfalse;
+
+        processor.setNonRealtime(config.offline);
+        processor.setRateAndBufferSizeDetails(config.sampleRate, config.blockSize);
+        processor.getOutputMeter().setReading(config.metering);
+
+        start = juce::Time::getHighResolutionTicks();
+        processor.prepareToPlay(config.sampleRate, config.blockSize);
+        prepareSeconds += juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        randomiseParameters(processor, config, random);
+        instance.automation = makeAutomation(processor, config, random);
+    }
+
+    result.constructMicroseconds = constructSeconds * 1.0e6 / config.numInstances;
+    result.prepareMicroseconds = prepareSeconds * 1.0e6 / config.numInstances;
+
+    juce::MidiBuffer midi;
+
+    auto fillInput = [&](Instance& instance, int instanceIndex, int block)
+    {
+        auto offset = (static_cast<juce::int64>(block) * config.blockSize + static_cast<juce::int64>(instanceIndex) * 997) % (sourceLength - config.blockSize + 1);
+
+        for (int channel = 0; channel < config.numChannels; ++channel)
+            instance.buffer.copyFrom(channel, 0, source, channel, static_cast<int>(offset), config.blockSize);
+    };
+
+    //warm-up: first designs, lazily created pool threads, caches and page faults settle before anything is measured.
+    for (int block = 0; block < numWarmUpBlocks; ++block)
+    {
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            auto& instance = instances[i];
+            fillInput(instance, static_cast<int>(i), block);
+
+            for (auto& automation : instance.automation)
+                automation.advance();
+
+            instance.processor->processBlock(instance.buffer, midi);
+        }
+    }
+
+    auto residentAfter = getResidentBytes();
+
+    if (residentBefore >= 0 && residentAfter >= 0)
+        result.residentBytesPerInstance = (residentAfter - residentBefore) / config.numInstances;
+
+    double totalProcessSeconds = 0.0;
+    int numOverruns = 0;
+
+    auto cpuStart = std::clock();
+
+    for (int block = 0; block < numMeasuredBlocks; ++block)
+    {
+        double callbackSeconds = 0.0;
+
+        for (size_t i = 0; i < instances.size(); ++i)
+        {
+            auto& instance = instances[i];
+            fillInput(instance, static_cast<int>(i), numWarmUpBlocks + block);
+
+            for (auto& automation : instance.automation)
+                automation.advance();
+
+            auto start = juce::Time::getHighResolutionTicks();
+            instance.processor->processBlock(instance.buffer, midi);
+            auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            instance.times[static_cast<size_t>(block)] = static_cast<float>(seconds * 1.0e6);
+            callbackSeconds += seconds;
+        }
+
+        totalProcessSeconds += callbackSeconds;
+
+        if (callbackSeconds > blockSeconds)
+            ++numOverruns;
+    }
+
+    auto cpuSeconds = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    auto audioSeconds = numMeasuredBlocks * blockSeconds;
+
+    result.wallLoad = totalProcessSeconds / audioSeconds;
+    result.cpuLoad = cpuSeconds / audioSeconds;
+    result.overrunFraction = static_cast<double>(numOverruns) / numMeasuredBlocks;
+
+    std::vector<float> p99s;
+
+    for (auto& instance : instances)
+        p99s.push_back(static_cast<float>(getPercentile(instance.times, 0.99)));
+
+    result.medianInstanceP99 = getPercentile(p99s, 0.5);
+    result.worstInstanceP99 = *std::max_element(p99s.begin(), p99s.end());
+
+    auto numSamples = static_cast<double>(config.numInstances) * numMeasuredBlocks * config.blockSize * config.numChannels;
+    result.nanosecondsPerSample = totalProcessSeconds * 1.0e9 / numSamples;
+
+    //timing a separate meter over as many blocks as one instance processed tells its share apart from the eq's.
+    OutputMeter meter;
+    meter.prepare(config.sampleRate, juce::AudioChannelSet::canonicalChannelSet(config.numChannels));
+    meter.setReading(true);
+
+    auto meterStart = juce::Time::getHighResolutionTicks();
+
+    for (int block = 0; block < numMeasuredBlocks; ++block)
+        meter.process(instances.front().buffer, config.numChannels);
+
+    auto meterSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - meterStart);
+    result.meterNanosecondsPerSample = meterSeconds * 1.0e9 / (static_cast<double>(numMeasuredBlocks) * config.blockSize * config.numChannels);
+
+    return result;
+}
+
+juce::String BenchmarkResult::getCsvHeader()
+{
+    return "instances,block,channels,sample_rate,topology,design,automated,offline,metering,threads,wall_load,cpu_load,overrun_fraction,median_p99_us,worst_p99_us,ns_per_sample,meter_ns_per_sample,meter_fraction,resident_bytes_per_instance,construct_us,prepare_us";
+}
+
+double BenchmarkResult::getMeterFraction() const
+{
+    auto eqNanosecondsPerSample = nanosecondsPerSample - (config.metering ? meterNanosecondsPerSample : 0.0);
+    return eqNanosecondsPerSample > 0.0 ? meterNanosecondsPerSample / eqNanosecondsPerSample : 0.0;
+}
+
+juce::String BenchmarkResult::toCsvLine() const
+{
+    juce::StringArray fields
+    {
+        juce::String(config.numInstances), juce::String(config.blockSize), juce::String(config.numChannels), juce::String(config.sampleRate),
+        juce::String(config.topology), juce::String(config.design), juce::String(config.numAutomatedParameters), config.offline ? "1" : "0", config.metering ? "1" : "0", juce::String(config.numThreads),
+        juce::String(wallLoad, 6), juce::String(cpuLoad, 6), juce::String(overrunFraction, 6),
+        juce::String(medianInstanceP99, 3), juce::String(worstInstanceP99, 3), juce::String(nanosecondsPerSample, 3),
+        juce::String(meterNanosecondsPerSample, 3), juce::String(getMeterFraction(), 6), juce::String(residentBytesPerInstance), juce::String(constructMicroseconds, 3), juce::String(prepareMicroseconds, 3)
+    };
+
+    return fields.joinIntoString(",");
+}
+
+juce::String BenchmarkResult::toString() const
+{
+    juce::String s;
+    s << juce::String(config.numInstances).paddedLeft(' ', 5) << " instances, block " << juce::String(config.blockSize).paddedLeft(' ', 5)
+      << (config.offline ? ", offline on " + juce::String(config.numThreads) + " threads" : juce::String())
+      << ": load " << juce::String(wallLoad * 100.0, 1) << "% wall / " << juce::String(cpuLoad * 100.0, 1) << "% cpu"
+      << ", overruns " << juce::String(overrunFraction * 100.0, 2) << "%"
+      << ", p99 " << juce::String(medianInstanceP99, 1) << " us median / " << juce::String(worstInstanceP99, 1) << " us worst"
+      << ", " << juce::String(nanosecondsPerSample, 2) << " ns/sample";
+
+    if (nanosecondsPerSample > 0.0)
+        s << " (metering " << juce::String(100.0 * getMeterFraction(), 1) << "% of the eq" << (config.metering ? ")" : " while shown, off in this run)");
+
+    if (residentBytesPerInstance >= 0)
+        s << ", " << juce::String(residentBytesPerInstance / 1024.0, 1) << " KB/instance";
+
+    s << ", construct " << juce::String(constructMicroseconds, 1) << " us / prepare " << juce::String(prepareMicroseconds, 1) << " us";
+
+    return s;
+}
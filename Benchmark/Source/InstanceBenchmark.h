@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    InstanceBenchmark.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+//how one run of the many-instance benchmark is set up. every instance gets its own buffers and its own random settings, so the working set grows with the instance count the way it does on a playback server.
+struct BenchmarkConfig
+{
+    int numInstances { 1 };
+    int blockSize { 256 };
+    int numChannels { 2 };
+    double sampleRate { 48000.0 };
+
+    //simulated audio time per run, the first second of it is a warm-up that isn't measured.
+    double seconds { 10.0 };
+
+    //-1 gives every instance a random topology / design, otherwise the FilterTopology / CoefficientDesign value everyone uses.
+    int topology { -1 };
+    int design { -1 };
+
+    //continuous parameters per instance that follow their own slow lfo, updated once per block like host automation.
+    int numAutomatedParameters { 2 };
+
+    //runs the processors with isNonRealtime() set, so large channel counts go through the channel thread pool.
+    bool offline { false };
+
+    //meters every instance's output the way an open editor does. off, the instances are headless.
+    bool metering { false };
+
+    //threads the channel thread pool spreads a block over, the calling thread included. 0 is the pool's default of one per cpu.
+    int numThreads { 0 };
+
+    juce::int64 seed { 1 };
+};
+
+struct BenchmarkResult
+{
+    BenchmarkConfig config;
+
+    //processing time over simulated audio time across every instance, 1.0 means one core is fully busy. wall and process cpu time are both reported, the difference is time spent on other threads (the channel pool) or waiting.
+    double wallLoad { 0.0 };
+    double cpuLoad { 0.0 };
+
+    //fraction of the simulated callbacks that took longer than the block lasts.
+    double overrunFraction { 0.0 };
+
+    //per-instance processBlock time in microseconds: the 99th percentile of each instance, then the median and worst of those across instances.
+    double medianInstanceP99 { 0.0 };
+    double worstInstanceP99 { 0.0 };
+
+    //mean processBlock time per instance and channel-sample, the number to watch for scaling cliffs.
+    double nanosecondsPerSample { 0.0 };
+
+    //what the output meter costs per channel-sample while it's metering, timed on its own over the same block size and channel count whether or not the instances meter. it runs warm in cache, so at high instance counts it's a lower bound.
+    double meterNanosecondsPerSample { 0.0 };
+
+    //the meter's cost over the eq's, the eq's being nanosecondsPerSample without the meter's part when the instances meter.
+    double getMeterFraction() const;
+
+    //resident memory added by creating and preparing the instances, -1 where the platform doesn't say.
+    juce::int64 residentBytesPerInstance { -1 };
+
+    //mean time to construct one processor and to run its first prepareToPlay, in microseconds. session load time is mostly these two.
+    double constructMicroseconds { 0.0 };
+    double prepareMicroseconds { 0.0 };
+
+    static juce::String getCsvHeader();
+    juce::String toCsvLine() const;
+    juce::String toString() const;
+};
+
+//creates the instances, randomises their parameters, and drives them from a simulated host callback on the calling thread, one instance after another per block.
+BenchmarkResult runInstanceBenchmark(const BenchmarkConfig& config);
+
+//resident set size of the process in bytes, or -1 if it can't be read on this platform.
+juce::int64 getResidentBytes();
@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "InstanceBenchmark.h"
+#include "SegmentRenderBenchmark.h"
+#include "MatchFitBenchmark.h"
+
+//headless many-instance benchmark. sweeps instance counts and block sizes and prints one line per run, optionally writing every run to a csv file for plotting.
+//
+//  --instances 1,8,64      instance counts, default powers of two from 1 to 1024
+//  --blocks 64,256         block sizes, default 64,256,1024,4096,16384 (the last one goes through the processor's tiling)
+//  --channels 2            channels per instance
+//  --rate 48000            sample rate
+//  --seconds 5             simulated audio per run, including a warm-up second
+//  --topology biquad|svf|random
+//  --design exact|fast|random
+//  --automation 2          automated parameters per instance, 0 for static settings
+//  --offline               run as a non-realtime render, channels go through the channel thread pool
+//  --metering              meter every instance's output, as with their editors open
+//  --threads 1,2,4         thread counts of the channel thread pool, the calling thread included. default is one per cpu
+//  --seed 1
+//  --csv results.csv
+//  --baseline before.csv   csv of an earlier build's run with the same options. prints the load and memory figures of every matching run next to this build's.
+//
+//  --segment-render        instead of the sweep, render one long stream serially and segmented and compare the two. uses --channels, --rate, --design, --seed, --threads and --seconds (default 600).
+//  --match-fit             instead of the sweep, time the match eq fit on random target curves and check it against its budget. uses --rate and --seed.
+
+static juce::Array<int> parseList(const juce::String& text)
+{
+    juce::Array<int> values;
+
+    for (auto& token : juce::StringArray::fromTokens(text, ",", {}))
+        if (token.getIntValue() > 0)
+            values.add(token.getIntValue());
+
+    return values;
+}
+
+static int parseChoice(const juce::String& text, const juce::StringArray& names)
+{
+    //-1 is random.
+    return names.indexOf(text, true);
+}
+
+//rows of a benchmark csv, keyed by the columns that describe the run. columns are looked up by name, so a baseline written by an older harness that lacks some of them still lines up.
+struct CsvTable
+{
+    explicit CsvTable(const juce::StringArray& lines)
+    {
+        header = juce::StringArray::fromTokens(lines[0], ",", {});
+
+        for (int i = 1; i < lines.size(); ++i)
+            if (lines[i].isNotEmpty())
+                rows.add(juce::StringArray::fromTokens(lines[i], ",", {}));
+    }
+
+    juce::String get(const juce::StringArray& row, const juce::String& column) const
+    {
+        auto index = header.indexOf(column);
+        return index >= 0 ? row[index] : juce::String();
+    }
+
+    juce::String getKey(const juce::StringArray& row, const juce::StringArray& keyColumns) const
+    {
+        juce::StringArray key;
+
+        for (auto& column : keyColumns)
+            key.add(get(row, column));
+
+        return key.joinIntoString(",");
+    }
+
+    juce::StringArray header;
+    juce::Array<juce::StringArray> rows;
+};
+
+static void printComparison(const juce::StringArray& csv, const juce::File& baselineFile)
+{
+    juce::StringArray baselineLines;
+    baselineFile.readLines(baselineLines);
+
+    if (baselineLines.isEmpty())
+    {
+        std::cerr << "couldn't read " << baselineFile.getFullPathName() << std::endl;
+        return;
+    }
+
+    CsvTable baseline(baselineLines), current(csv);
+
+    //the run is identified by whichever of its settings both files have.
+    juce::StringArray keyColumns;
+
+    for (auto column : { "instances", "block", "channels", "sample_rate", "topology", "design", "automated", "offline", "metering", "threads" })
+        if (baseline.header.contains(column) && current.header.contains(column))
+            keyColumns.add(column);
+
+    static const char* const figures[] { "construct_us", "prepare_us", "resident_bytes_per_instance", "ns_per_sample", "wall_load" };
+
+    for (auto& row : current.rows)
+    {
+        auto key = current.getKey(row, keyColumns);
+
+        for (auto& baselineRow : baseline.rows)
+        {
+            if (baseline.getKey(baselineRow, keyColumns) != key)
+                continue;
+
+            juce::String line;
+            line << "baseline vs this build, " << current.get(row, "instances") << " instances, block " << current.get(row, "block") << ":";
+
+            for (auto* figure : figures)
+            {
+                auto before = baseline.get(baselineRow, figure), after = current.get(row, figure);
+
+                line << " " << figure << " ";
+
+                if (before.isEmpty() || before.getDoubleValue() <= 0.0 || after.getDoubleValue() <= 0.0)
+                    line << (before.isEmpty() ? "n/a" : before) << " -> " << after;
+                else
+                    line << before << " -> " << after << " (" << juce::String((after.getDoubleValue() / before.getDoubleValue() - 1.0) * 100.0, 1) << " %)";
+            }
+
+            std::cout << line << std::endl;
+            break;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    juce::Array<int> instanceCounts { 1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024 };
+    juce::Array<int> blockSizes { 64, 256, 1024, 4096, 16384 };
+    juce::Array<int> threadCounts { 0 };
+
+    BenchmarkConfig config;
+    config.seconds = 5.0;
+
+    if (args.containsOption("--instances"))  instanceCounts = parseList(args.getValueForOption("--instances"));
+    if (args.containsOption("--blocks"))     blockSizes = parseList(args.getValueForOption("--blocks"));
+    if (args.containsOption("--threads"))    threadCounts = parseList(args.getValueForOption("--threads"));
+    if (args.containsOption("--channels"))   config.numChannels = juce::jmax(1, args.getValueForOption("--channels").getIntValue());
+    if (args.containsOption("--rate"))       config.sampleRate = juce::jmax(8000.0, args.getValueForOption("--rate").getDoubleValue());
+    if (args.containsOption("--seconds"))    config.seconds = juce::jmax(0.1, args.getValueForOption("--seconds").getDoubleValue());
+    if (args.containsOption("--topology"))   config.topology = parseChoice(args.getValueForOption("--topology"), { "biquad", "svf" });
+    if (args.containsOption("--design"))     config.design = parseChoice(args.getValueForOption("--design"), { "exact", "fast" });
+    if (args.containsOption("--automation")) config.numAutomatedParameters = juce::jmax(0, args.getValueForOption("--automation").getIntValue());
+    if (args.containsOption("--seed"))       config.seed = args.getValueForOption("--seed").getLargeIntValue();
+
+    config.offline = args.containsOption("--offline");
+    config.metering = args.containsOption("--metering");
+
+    if (args.containsOption("--match-fit"))
+    {
+        auto result = runMatchFitBenchmark(config);
+        std::cout << result.toString() << std::endl;
+
+        return result.isWithinBudget() ? 0 : 1;
+    }
+
+    if (args.containsOption("--segment-render"))
+    {
+        if (! args.containsOption("--seconds"))
+            config.seconds = 600.0;
+
+        if (threadCounts.isEmpty())
+        {
+            std::cerr << "--threads takes comma separated positive integers" << std::endl;
+            return 1;
+        }
+
+        auto allWithinBound = true;
+
+        for (auto numThreads : threadCounts)
+        {
+            auto runConfig = config;
+            runConfig.numThreads = numThreads;
+
+            auto result = runSegmentRenderBenchmark(runConfig);
+            std::cout << result.toString() << std::endl;
+
+            allWithinBound = allWithinBound && result.isWithinBound();
+        }
+
+        return allWithinBound ? 0 : 1;
+    }
+
+    if (instanceCounts.isEmpty() || blockSizes.isEmpty() || threadCounts.isEmpty())
+    {
+        std::cerr << "--instances, --blocks and --threads take comma separated positive integers" << std::endl;
+        return 1;
+    }
+
+    juce::StringArray csv { BenchmarkResult::getCsvHeader() };
+
+    for (auto numThreads : threadCounts)
+    {
+        for (auto blockSize : blockSizes)
+        {
+            for (auto numInstances : instanceCounts)
+            {
+                auto runConfig = config;
+                runConfig.blockSize = blockSize;
+                runConfig.numInstances = numInstances;
+                runConfig.numThreads = numThreads;
+
+                auto result = runInstanceBenchmark(runConfig);
+
+                std::cout << result.toString() << std::endl;
+                csv.add(result.toCsvLine());
+            }
+        }
+    }
+
+    if (args.containsOption("--csv"))
+    {
+        juce::File file(juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--csv")));
+
+        if (! file.replaceWithText(csv.joinIntoString("\n") + "\n"))
+        {
+            std::cerr << "couldn't write " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+
+    if (args.containsOption("--baseline"))
+        printComparison(csv, juce::File::getCurrentWorkingDirectory().getChildFile(args.getValueForOption("--baseline")));
+
+    return 0;
+}
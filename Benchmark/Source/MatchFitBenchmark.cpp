@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    MatchFitBenchmark.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "MatchFitBenchmark.h"
+#include "../../Source/MatchEQ.h"
+
+namespace
+{
+    //one fit per target, each from a fresh seed.
+    constexpr int numTargets = 8;
+
+    //what match() hands the fit: a smoothed difference of two spectra, level removed and limited to +-24 dB. a tilt plus a few broad bumps covers what two mixes usually differ by.
+    std::vector<float> makeRandomTarget(const std::vector<double>& frequencies, juce::Random& random)
+    {
+        std::vector<float> target(frequencies.size());
+
+        auto tilt = (random.nextFloat() * 2.f - 1.f) * 3.f;
+
+        for (size_t i = 0; i < target.size(); ++i)
+            target[i] = tilt * static_cast<float>(std::log2(frequencies[i] / 1000.0));
+
+        for (int bump = 0; bump < 4; ++bump)
+        {
+            auto centre = juce::mapToLog10(random.nextDouble(), 20.0, 20000.0);
+            auto width = 0.3 + random.nextDouble() * 1.5;
+            auto gain = (random.nextDouble() * 2.0 - 1.0) * 9.0;
+
+            for (size_t i = 0; i < target.size(); ++i)
+            {
+                auto octaves = std::log2(frequencies[i] / centre) / width;
+                target[i] += static_cast<float>(gain * std::exp(-0.5 * octaves * octaves));
+            }
+        }
+
+        auto mean = std::accumulate(target.begin(), target.end(), 0.f) / static_cast<float>(target.size());
+
+        for (auto& value : target)
+            value = juce::jlimit(-24.f, 24.f, value - mean);
+
+        return target;
+    }
+}
+
+MatchFitResult runMatchFitBenchmark(const BenchmarkConfig& config)
+{
+    MatchFitResult result;
+    result.config = config;
+
+    //the fit reads the parameter ranges from an apvts, a processor is the simplest way to get one.
+    RuckusEQAudioProcessor processor;
+
+    auto frequencies = MatchEQ::makeGridFrequencies();
+    MagnitudeGrid grid;
+    grid.prepare(frequencies, config.sampleRate);
+
+    //the same start match() uses: flat bands, cuts wide open at their gentlest slope.
+    auto start = getChainSettings(processor.apvts);
+
+    for (auto& peak : start.peaks)
+        peak.gainInDecibels = 0.f;
+
+    start.highPassFreq = processor.apvts.getParameterRange("HighPass Freq").start;
+    start.lowPassFreq = processor.apvts.getParameterRange("LowPass Freq").end;
+    start.highPassSlope = start.lowPassSlope = Slope::Slope_12;
+
+    juce::Random random(config.seed);
+    auto totalSeconds = 0.0;
+
+    for (int i = 0; i < numTargets; ++i)
+    {
+        auto target = makeRandomTarget(frequencies, random);
+
+        auto ticks = juce::Time::getHighResolutionTicks();
+        auto fitted = MatchEQ::fit(target, grid, processor.apvts, start);
+        auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - ticks);
+
+        juce::ignoreUnused(fitted);
+
+        totalSeconds += seconds;
+        result.worstMilliseconds = juce::jmax(result.worstMilliseconds, seconds * 1000.0);
+    }
+
+    result.numFits = numTargets;
+    result.meanMilliseconds = totalSeconds * 1000.0 / numTargets;
+
+    return result;
+}
+
+juce::String MatchFitResult::toString() const
+{
+    juce::String s;
+    s << "match eq fit of " << numPeakBands << " bands at " << juce::String(config.sampleRate, 0) << " Hz, " << numFits << " targets: "
+      << juce::String(meanMilliseconds, 1) << " ms mean, " << juce::String(worstMilliseconds, 1) << " ms worst"
+      << " against a budget of " << juce::String(budgetMilliseconds, 0) << " ms"
+      << (isWithinBudget() ? " (within budget)" : " (OVER BUDGET)");
+
+    return s;
+}
@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    MatchFitBenchmark.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "InstanceBenchmark.h"
+
+//times MatchEQ::fit on random target curves, the part of a match that keeps the user waiting. uses sampleRate and seed from the config.
+struct MatchFitResult
+{
+    BenchmarkConfig config;
+
+    int numFits { 0 };
+    double meanMilliseconds { 0.0 }, worstMilliseconds { 0.0 };
+
+    //the search resolution in MatchEQ.cpp is sized for a fit of about a quarter of a second on one desktop core.
+    static constexpr double budgetMilliseconds = 250.0;
+
+    bool isWithinBudget() const noexcept { return worstMilliseconds <= budgetMilliseconds; }
+
+    juce::String toString() const;
+};
+
+MatchFitResult runMatchFitBenchmark(const BenchmarkConfig& config);
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    SegmentRenderBenchmark.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "SegmentRenderBenchmark.h"
+
+namespace
+{
+    //same spread as the instance benchmark: gains mostly within +/-12 dB, moderate Qs, most bands in use. the high pass is kept low, that's where the longest tails are.
+    ChainSettings makeRandomSettings(const BenchmarkConfig& config, juce::Random& random)
+    {
+        auto settings = getDefaultChainSettings();
+
+        for (size_t band = 0; band < numPeakBands; ++band)
+        {
+            const auto& descriptor = peakBands[band];
+            auto& peak = settings.peaks[band];
+
+            peak.freq = descriptor.minFreq + random.nextFloat() * (descriptor.maxFreq - descriptor.minFreq);
+            peak.gainInDecibels = (random.nextFloat() + random.nextFloat() + random.nextFloat() - 1.5f) * 8.f;
+            peak.quality = 0.1f + random.nextFloat() * (descriptor.maxQuality - 0.1f);
+            peak.isOn = random.nextFloat() < 0.85f;
+        }
+
+        settings.highPassFreq = 10.f + random.nextFloat() * 90.f;
+        settings.lowPassFreq = 3000.f + random.nextFloat() * 18000.f;
+        settings.highPassSlope = static_cast<Slope>(random.nextInt(4));
+        settings.lowPassSlope = static_cast<Slope>(random.nextInt(4));
+        settings.design = config.design == CoefficientDesign::Design_Fast ? CoefficientDesign::Design_Fast : CoefficientDesign::Design_Exact;
+
+        return settings;
+    }
+
+    //one channel through the chain's sections in double precision, transposed direct form II like the juce filters, calling compare(i, sample) for every output sample. the coefficients are the float ones the chain runs, so what's left against a float render is that render's rounding.
+    template <typename Compare>
+    void renderInDouble(const ChainResponse& response, const float* input, int numSamples, Compare&& compare)
+    {
+        std::array<std::array<double, 2>, maxChainStages> state {};
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto sample = static_cast<double>(input[i]);
+
+            for (size_t stage = 0; stage < response.numStages; ++stage)
+            {
+                const auto& c = response.stages[stage];
+                auto& s = state[stage];
+
+                auto output = c[0] * sample + s[0];
+                s[0] = c[1] * sample - c[3] * output + s[1];
+                s[1] = c[2] * sample - c[4] * output;
+                sample = output;
+            }
+
+            compare(i, sample);
+        }
+    }
+}
+
+SegmentRenderResult runSegmentRenderBenchmark(const BenchmarkConfig& config)
+{
+    SegmentRenderResult result;
+    result.config = config;
+
+    juce::Random random(config.seed);
+    auto settings = makeRandomSettings(config, random);
+
+    auto numSamples = juce::jmax(1, static_cast<int>(config.seconds * config.sampleRate));
+    juce::AudioBuffer<float> input(config.numChannels, numSamples);
+
+    //noise through a one pole lowpass, so the low end that rings longest gets plenty of energy.
+    for (int channel = 0; channel < config.numChannels; ++channel)
+    {
+        auto state = 0.f;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            state += 0.01f * ((random.nextFloat() * 2.f - 1.f) - state);
+            input.setSample(channel, i, juce::jlimit(-1.f, 1.f, state * 8.f));
+        }
+    }
+
+    auto peak = input.getMagnitude(0, numSamples);
+
+    //serial reference, one freshly reset chain per channel.
+    juce::AudioBuffer<float> serial(input);
+
+    auto start = juce::Time::getHighResolutionTicks();
+
+    for (int channel = 0; channel < config.numChannels; ++channel)
+    {
+        MonoChain chain;
+        updateMonoChain(chain, settings, config.sampleRate);
+        chain.prepare({ config.sampleRate, 4096, 1 });
+
+        juce::dsp::AudioBlock<float> block(serial);
+        auto channelBlock = block.getSingleChannelBlock(static_cast<size_t>(channel));
+
+        for (size_t offset = 0; offset < channelBlock.getNumSamples(); offset += 4096)
+        {
+            auto tile = channelBlock.getSubBlock(offset, juce::jmin(static_cast<size_t>(4096), channelBlock.getNumSamples() - offset));
+            juce::dsp::ProcessContextReplacing<float> context(tile);
+            chain.process(context);
+        }
+    }
+
+    result.serialSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+    juce::AudioBuffer<float> segmented(input);
+    juce::SharedResourcePointer<ChannelThreadPool> threads;
+    threads->setNumThreads(config.numThreads);
+    result.config.numThreads = threads->getNumThreads();
+
+    start = juce::Time::getHighResolutionTicks();
+    renderSegmented(settings, config.sampleRate, segmented.getArrayOfWritePointers(), config.numChannels, numSamples, *threads);
+    result.segmentedSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+    MonoChain chain;
+    updateMonoChain(chain, settings, config.sampleRate);
+
+    ChainResponse response;
+    captureResponse(chain, config.sampleRate, response);
+
+    //the warm-up the render actually ran, 0 when it didn't split the stream.
+    result.warmUpLength = planSegments(response, config.numChannels, numSamples, result.config.numThreads).warmUpLength;
+
+    for (int channel = 0; channel < config.numChannels; ++channel)
+    {
+        auto* serialSamples = serial.getReadPointer(channel);
+        auto* segmentedSamples = segmented.getReadPointer(channel);
+
+        renderInDouble(response, input.getReadPointer(channel), numSamples, [&](int i, double expected)
+        {
+            result.roundingError = juce::jmax(result.roundingError, std::abs(serialSamples[i] - expected));
+            result.maxError = juce::jmax(result.maxError, std::abs(segmentedSamples[i] - expected));
+        });
+    }
+
+    if (peak > 0.f)
+    {
+        result.maxError /= peak;
+        result.roundingError /= peak;
+    }
+
+    return result;
+}
+
+juce::String SegmentRenderResult::toString() const
+{
+    juce::String s;
+    s << "segmented render of " << juce::String(config.seconds, 1) << " s x " << config.numChannels << " channels: "
+      << juce::String(serialSeconds * 1000.0, 1) << " ms serial, " << juce::String(segmentedSeconds * 1000.0, 1) << " ms segmented on " << config.numThreads << " threads"
+      << " (" << juce::String(serialSeconds / juce::jmax(1.0e-9, segmentedSeconds), 2) << "x)"
+      << ", warm-up " << juce::String(warmUpLength) << " samples"
+      << ", max error " << juce::String(juce::Decibels::gainToDecibels(maxError, -300.0), 1) << " dB"
+      << " against " << juce::String(juce::Decibels::gainToDecibels(roundingError, -300.0), 1) << " dB for the serial float render"
+      << (isWithinBound() ? " (within bound)" : " (OUT OF BOUND)");
+
+    return s;
+}
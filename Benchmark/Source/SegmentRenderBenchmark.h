@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    SegmentRenderBenchmark.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/SegmentRender.h"
+#include "InstanceBenchmark.h"
+
+//serial against segmented rendering of one long stream with random settings. uses seconds, numChannels, sampleRate, design, seed and numThreads from the config.
+//both float renders are measured against a serial render in double precision with the same coefficients, so the float rounding of the serial render itself is known and the warm-up bound is checked on top of it.
+struct SegmentRenderResult
+{
+    BenchmarkConfig config;
+
+    double serialSeconds { 0.0 }, segmentedSeconds { 0.0 };
+    juce::int64 warmUpLength { 0 };
+
+    //largest difference of the segmented render from the double precision render, relative to the input's peak level.
+    double maxError { 0.0 };
+
+    //the same for the serial float render. with low cut sections this is around 1e-4, far above segmentRenderErrorBound.
+    double roundingError { 0.0 };
+
+    //the segmented render rounds differently from the serial one after every cut, so its own rounding is another draw of about the same size. twice the serial render's is allowed for it.
+    double getRoundingAllowance() const noexcept { return 2.0 * roundingError; }
+
+    bool isWithinBound() const noexcept { return maxError <= segmentRenderErrorBound + getRoundingAllowance(); }
+
+    juce::String toString() const;
+};
+
+SegmentRenderResult runSegmentRenderBenchmark(const BenchmarkConfig& config);
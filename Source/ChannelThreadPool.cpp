@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    ChannelThreadPool.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "ChannelThreadPool.h"
+
+//set while a thread works on a job, the calling thread included. a task that calls parallelFor again gets its inner job run serially: the workers are all busy with the outer job, and the calling thread already holds the recursive lock, so it would overwrite the job it's in the middle of.
+static thread_local bool isRunningTasks = false;
+
+ChannelThreadPool::ChannelThreadPool()
+    : numWorkers(getDefaultNumWorkers())
+{
+}
+
+ChannelThreadPool::~ChannelThreadPool()
+{
+    stopWorkers();
+}
+
+void ChannelThreadPool::setNumThreads(int numThreads)
+{
+    const juce::ScopedLock sl(lock);
+
+    auto newNumWorkers = numThreads > 0 ? numThreads - 1 : getDefaultNumWorkers();
+
+    if (newNumWorkers == numWorkers.load())
+        return;
+
+    auto wereRunning = ! workers.isEmpty();
+
+    stopWorkers();
+    numWorkers = newNumWorkers;
+
+    if (wereRunning)
+        startWorkers();
+}
+
+void ChannelThreadPool::startWorkers()
+{
+    const juce::ScopedLock sl(lock);
+
+    if (! workers.isEmpty())
+        return;
+
+    for (int i = 0; i < numWorkers.load(); i++)
+        workers.add(new Worker(*this))->startThread();
+}
+
+void ChannelThreadPool::stopWorkers()
+{
+    for (auto* worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->wakeUp.signal();
+    }
+
+    for (auto* worker : workers)
+        worker->stopThread(1000);
+
+    workers.clear();
+}
+
+void ChannelThreadPool::Worker::run()
+{
+    while (! threadShouldExit())
+    {
+        wakeUp.wait(-1);
+
+        if (threadShouldExit())
+            break;
+
+        pool.runTasks();
+
+        //the last worker out lets the caller return.
+        if (pool.activeWorkers.fetch_sub(1) == 1)
+            pool.finished.signal();
+    }
+}
+
+void ChannelThreadPool::runTasks()
+{
+    isRunningTasks = true;
+
+    for (;;)
+    {
+        auto index = nextTask.fetch_add(1);
+
+        if (index >= numTasksInJob)
+            break;
+
+        taskFunction(taskContext, index);
+    }
+
+    isRunningTasks = false;
+}
+
+void ChannelThreadPool::run(int numTasks, TaskFunction function, void* context)
+{
+    //checked before taking the lock, which is recursive and would let a nested call through on the calling thread.
+    if (isRunningTasks)
+    {
+        jassertfalse; //a task called parallelFor. it still works, but only on this one thread.
+
+        for (int i = 0; i < numTasks; i++)
+            function(context, i);
+
+        return;
+    }
+
+    const juce::ScopedTryLock tryLock(lock);
+
+    //starting threads here would stall whoever is processing, so until startWorkers() has run every job stays on the calling thread.
+    const auto numWorkersInJob = tryLock.isLocked() ? workers.size() : 0;
+
+    if (numWorkersInJob == 0 || numTasks < 2)
+    {
+        for (int i = 0; i < numTasks; i++)
+            function(context, i);
+
+        return;
+    }
+
+    taskFunction = function;
+    taskContext = context;
+    numTasksInJob = numTasks;
+    nextTask = 0;
+
+    //don't wake more workers than there is work for.
+    auto numToWake = juce::jmin(numWorkersInJob, numTasks - 1);
+    activeWorkers = numToWake;
+
+    for (int i = 0; i < numToWake; i++)
+        workers[i]->wakeUp.signal();
+
+    runTasks();
+
+    //wait for every woken worker to leave runTasks, so none of them can still be looking at this job when the next one is set up.
+    while (activeWorkers.load() > 0)
+        finished.wait(-1);
+}
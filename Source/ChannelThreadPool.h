@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    ChannelThreadPool.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//small fork/join pool used to spread independent channels across cores during offline rendering.
+//workers (and the calling thread) pull the next task index from a shared counter, so a worker that finishes early simply takes more of the remaining work.
+//tasks are whole channels of one block, all about the same size and far fewer than a hundred per job, so one fetch_add per task already balances the load and there's nothing for per-worker queues and stealing to win back.
+//one pool is shared by every instance in the process through juce::SharedResourcePointer. worker threads are only started by startWorkers(), which an instance calls once it's rendering offline, so sessions that only play in real time never create them.
+class ChannelThreadPool
+{
+public:
+    ChannelThreadPool();
+    ~ChannelThreadPool();
+
+    //runs task(i) for every i in [0, numTasks) and returns once all of them are done. never allocates, and never starts threads.
+    //the tasks run serially on the calling thread instead of waiting when the workers haven't been started, another instance is already using the pool, or the call comes from inside a task of another job.
+    template <typename Task>
+    void parallelFor(int numTasks, Task& task)
+    {
+        run(numTasks, [](void* context, int index) { (*static_cast<Task*>(context))(index); }, &task);
+    }
+
+    //creates the worker threads if they aren't running yet. waits for a job that's running on the pool to finish, so keep it off the audio thread.
+    void startWorkers();
+
+    //the number of threads a job is spread over, the calling thread included. 0 goes back to the default of one per cpu.
+    //waits for a job that's running on the pool to finish. workers that were running are restarted with the new count.
+    void setNumThreads(int numThreads);
+
+    int getNumThreads() const noexcept { return numWorkers.load() + 1; }
+
+private:
+    using TaskFunction = void (*)(void*, int);
+
+    struct Worker : juce::Thread
+    {
+        Worker(ChannelThreadPool& p) : juce::Thread("RuckusEQ channel worker"), pool(p) {}
+        void run() override;
+
+        ChannelThreadPool& pool;
+        juce::WaitableEvent wakeUp;
+    };
+
+    void run(int numTasks, TaskFunction function, void* context);
+    void runTasks();
+    void stopWorkers();
+
+    static int getDefaultNumWorkers() { return juce::jmax(0, juce::SystemStats::getNumCpus() - 1); }
+
+    std::atomic<int> numWorkers;
+    juce::OwnedArray<Worker> workers;
+
+    juce::CriticalSection lock;
+    juce::WaitableEvent finished;
+
+    TaskFunction taskFunction { nullptr };
+    void* taskContext { nullptr };
+    int numTasksInJob { 0 };
+    std::atomic<int> nextTask { 0 }, activeWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ChannelThreadPool)
+};
@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+    FastDesign.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SvfFilter.h"
+
+//cheap coefficient design for automation heavy sessions. the std trig and pow calls are replaced by short polynomials that are accurate to float precision on the argument ranges the designs actually use, and every band is designed in the same loop so the compiler can vectorise across bands.
+//the approximations stay within 3e-7 relative error (tan, sin/cos and 10^x) over the frequency (10 Hz-22 kHz at 44.1-192 kHz), gain (+-24 dB) and Q ranges of createParameterLayout.
+//measured against the exact designs in float with measureFastDesignAccuracy (ReferenceFilters.h): the fast svf response deviates by less than 0.0001 dB anywhere above -60 dB, the fast biquad by less than 0.05 dB. getFastDesignTolerance holds both to that.
+namespace FastDesign
+{
+    constexpr float pi = juce::MathConstants<float>::pi;
+
+    //sin(y) and cos(y) for y in [0, pi/2], taylor series truncated where the remainder drops below float resolution (< 6e-8 absolute).
+    inline float sinPoly(float y) noexcept
+    {
+        auto y2 = y * y;
+        return y * (1.f + y2 * (-1.f / 6.f + y2 * (1.f / 120.f + y2 * (-1.f / 5040.f + y2 * (1.f / 362880.f + y2 * (-1.f / 39916800.f))))));
+    }
+
+    inline float cosPoly(float y) noexcept
+    {
+        auto y2 = y * y;
+        return 1.f + y2 * (-0.5f + y2 * (1.f / 24.f + y2 * (-1.f / 720.f + y2 * (1.f / 40320.f + y2 * (-1.f / 3628800.f + y2 * (1.f / 479001600.f))))));
+    }
+
+    //tan(pi * x) for x in [0, 0.5). arguments above 0.25 are folded onto 0.5 - x and the result inverted, so the polynomials only ever see [0, pi/4] and the relative error stays around 1e-7 right up to nyquist.
+    inline float tanPi(float x) noexcept
+    {
+        auto reflect = x > 0.25f;
+        auto y = (reflect ? 0.5f - x : x) * pi;
+        auto s = sinPoly(y);
+        auto c = cosPoly(y);
+        return reflect ? c / s : s / c;
+    }
+
+    //sin and cos of w for w in [0, pi], folded onto [0, pi/2].
+    inline void sinCos(float w, float& sinW, float& cosW) noexcept
+    {
+        auto reflect = w > 0.5f * pi;
+        auto y = reflect ? pi - w : w;
+        sinW = sinPoly(y);
+        cosW = reflect ? -cosPoly(y) : cosPoly(y);
+    }
+
+    //10^x. split into 2^n * 2^f with |f| <= 0.5, 2^f from a degree 7 polynomial (relative error < 1e-8) and 2^n written straight into the exponent bits. valid while the result is a normal float.
+    //n is rounded with a conversion rather than std::floor, which without sse4.1 is a library call and stops loops over this from vectorising.
+    inline float exp10(float x) noexcept
+    {
+        auto y = x * 3.32192809f; //log2(10)
+        auto n = static_cast<int>(y + (y < 0.f ? -0.5f : 0.5f));
+        auto f = (y - static_cast<float>(n)) * 0.693147181f; //ln(2)
+
+        auto p = 1.f + f * (1.f + f * (0.5f + f * (1.f / 6.f + f * (1.f / 24.f + f * (1.f / 120.f + f * (1.f / 720.f + f * (1.f / 5040.f)))))));
+
+        auto bits = static_cast<juce::int32>((n + 127) << 23);
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(float));
+
+        return p * scale;
+    }
+
+    //log10(x) for positive normal floats. integer ops split x into 2^e * m with m in [sqrt(0.5), sqrt(2)), ln(m) comes from the atanh series truncated below float resolution. within 6e-5 dB of 10 log10 for powers from 1e-20 up.
+    inline float log10(float x) noexcept
+    {
+        juce::int32 bits;
+        std::memcpy(&bits, &x, sizeof(float));
+
+        auto e = (bits - 0x3f3504f3) >> 23; //0x3f3504f3 is sqrt(0.5)
+        bits -= e * (1 << 23);
+
+        float m;
+        std::memcpy(&m, &bits, sizeof(float));
+
+        auto z = (m - 1.f) / (m + 1.f);
+        auto z2 = z * z;
+        auto lnM = 2.f * z * (1.f + z2 * (1.f / 3.f + z2 * (1.f / 5.f + z2 * (1.f / 7.f))));
+
+        return (static_cast<float>(e) * 0.693147181f + lnM) * 0.434294482f; //ln(2), 1 / ln(10)
+    }
+
+    //cutoff over sample rate, clamped just below nyquist like svfPrewarp.
+    inline float normalisedFrequency(float frequency, double sampleRate) noexcept
+    {
+        return juce::jlimit(1.f / static_cast<float>(sampleRate), 0.499f, static_cast<float>(frequency / sampleRate));
+    }
+
+    inline float svfPrewarp(float frequency, double sampleRate) noexcept
+    {
+        return tanPi(normalisedFrequency(frequency, sampleRate));
+    }
+
+    //normalised second order section in juce's raw coefficient order: b0, b1, b2, a1, a2 (a0 divided out).
+    using BiquadCoefficients = std::array<float, 5>;
+
+    //the peak bands as structure of arrays so one loop can run across all of them. the design functions only look at the first numBands entries, so callers can pack just the bands that are on to the front.
+    template <size_t NumBands>
+    struct PeakBands
+    {
+        std::array<float, NumBands> freq, quality, gainInDecibels;
+    };
+
+    //same design as IIR::Coefficients::makePeakFilter, A = 10^(dB/40) replaces the pow + sqrt.
+    template <size_t NumBands>
+    void designPeakBiquads(const PeakBands<NumBands>& bands, double sampleRate, std::array<BiquadCoefficients, NumBands>& coefficients, size_t numBands = NumBands) noexcept
+    {
+        for (size_t i = 0; i < numBands; ++i)
+        {
+            auto A = exp10(bands.gainInDecibels[i] * 0.025f);
+            auto w = 2.f * pi * normalisedFrequency(bands.freq[i], sampleRate);
+
+            float sinW, cosW;
+            sinCos(w, sinW, cosW);
+
+            auto alpha = sinW / (2.f * bands.quality[i]);
+            auto c2 = -2.f * cosW;
+            auto a0 = 1.f / (1.f + alpha / A);
+
+            coefficients[i] = { (1.f + alpha * A) * a0, c2 * a0, (1.f - alpha * A) * a0, c2 * a0, (1.f - alpha / A) * a0 };
+        }
+    }
+
+    //same design as makeSvfPeak.
+    template <size_t NumBands>
+    void designPeakSvfs(const PeakBands<NumBands>& bands, double sampleRate, std::array<SvfCoefficients, NumBands>& coefficients, size_t numBands = NumBands) noexcept
+    {
+        for (size_t i = 0; i < numBands; ++i)
+        {
+            auto A = exp10(bands.gainInDecibels[i] * 0.025f);
+            auto k = 1.f / (bands.quality[i] * A);
+
+            coefficients[i] = { svfPrewarp(bands.freq[i], sampleRate), k, 1.f, k * (A * A - 1.f), 0.f };
+        }
+    }
+
+    //butterworth cascade with the same sections as FilterDesign::designIIR*HighOrderButterworthMethod and IIR::Coefficients::makeHighPass/makeLowPass, all sharing a single tan().
+    inline std::array<BiquadCoefficients, 4> designButterworthBiquads(float frequency, double sampleRate, int slope, bool isHighPass) noexcept
+    {
+        std::array<BiquadCoefficients, 4> coefficients {};
+
+        auto t = tanPi(normalisedFrequency(frequency, sampleRate));
+        auto n = isHighPass ? t : 1.f / t;
+        auto n2 = n * n;
+        auto sign = isHighPass ? -1.f : 1.f;
+
+        for (int i = 0; i <= slope; ++i)
+        {
+            auto k = butterworthDamping[slope][i];
+            auto c1 = 1.f / (1.f + k * n + n2);
+
+            coefficients[i] = { c1, sign * 2.f * c1, c1, -sign * 2.f * c1 * (n2 - 1.f), c1 * (1.f - k * n + n2) };
+        }
+
+        return coefficients;
+    }
+}
+
+//writes a fast design straight into an existing coefficients object so no new one has to be allocated.
+inline void updateCoefficients(juce::dsp::IIR::Filter<float>::CoefficientsPtr& old, const FastDesign::BiquadCoefficients& replacements)
+{
+    //the default filter coefficients are first order, grow them to second order once and reuse the storage after that.
+    if (old->coefficients.size() != static_cast<int>(replacements.size()))
+        old->coefficients.resize(static_cast<int>(replacements.size()));
+
+    std::copy(replacements.begin(), replacements.end(), old->getRawCoefficients());
+}
@@ -0,0 +1,310 @@
+/*
+  ==============================================================================
+
+    FilterChain.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "FilterChain.h"
+
+void updateCoefficients(Coefficients& old, const Coefficients &replacements)
+{
+    //copy in place when the order matches, assigning the whole object reallocates its coefficient array for every chain on every block.
+    if (old->coefficients.size() == replacements->coefficients.size())
+        std::copy(replacements->coefficients.begin(), replacements->coefficients.end(), old->coefficients.begin());
+    else
+        *old = *replacements;
+}
+
+Coefficients makePeakFilter(const PeakBandSettings& band, double sampleRate)
+{
+    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, band.freq, band.quality, juce::Decibels::decibelsToGain(band.gainInDecibels));
+}
+
+std::array<Coefficients, numPeakBands> makePeakFilters(const ChainSettings& chainSettings, double sampleRate)
+{
+    std::array<Coefficients, numPeakBands> coefficients;
+    
+    for (size_t band = 0; band < numPeakBands; ++band)
+        if (chainSettings.peaks[band].isOn)
+            coefficients[band] = makePeakFilter(chainSettings.peaks[band], sampleRate);
+    
+    return coefficients;
+}
+
+SvfCoefficients makeSvfPeakFilter(float freq, float quality, float gainInDecibels, double sampleRate)
+{
+    return makeSvfPeak(sampleRate, freq, quality, juce::Decibels::decibelsToGain(gainInDecibels));
+}
+
+//packs the bands that are on to the front of the arrays so the fast designs can run across just those in one loop. bandIndex maps each packed entry back to its band.
+static size_t getActivePeakBands(const ChainSettings& chainSettings, FastDesign::PeakBands<numPeakBands>& bands, std::array<size_t, numPeakBands>& bandIndex)
+{
+    size_t numActive = 0;
+    
+    for (size_t band = 0; band < numPeakBands; ++band)
+    {
+        const auto& peak = chainSettings.peaks[band];
+        
+        if (! peak.isOn)
+            continue;
+        
+        bands.freq[numActive] = peak.freq;
+        bands.quality[numActive] = peak.quality;
+        bands.gainInDecibels[numActive] = peak.gainInDecibels;
+        bandIndex[numActive] = band;
+        ++numActive;
+    }
+    
+    return numActive;
+}
+
+std::array<FastDesign::BiquadCoefficients, numPeakBands> makeFastPeakFilters(const ChainSettings& chainSettings, double sampleRate)
+{
+    FastDesign::PeakBands<numPeakBands> bands;
+    std::array<size_t, numPeakBands> bandIndex;
+    auto numActive = getActivePeakBands(chainSettings, bands, bandIndex);
+    
+    std::array<FastDesign::BiquadCoefficients, numPeakBands> packed, coefficients {};
+    FastDesign::designPeakBiquads(bands, sampleRate, packed, numActive);
+    
+    for (size_t i = 0; i < numActive; ++i)
+        coefficients[bandIndex[i]] = packed[i];
+    
+    return coefficients;
+}
+
+std::array<SvfCoefficients, numPeakBands> makeSvfPeakFilters(const ChainSettings& chainSettings, double sampleRate)
+{
+    std::array<SvfCoefficients, numPeakBands> coefficients;
+    
+    if (chainSettings.design == CoefficientDesign::Design_Fast)
+    {
+        FastDesign::PeakBands<numPeakBands> bands;
+        std::array<size_t, numPeakBands> bandIndex;
+        auto numActive = getActivePeakBands(chainSettings, bands, bandIndex);
+        
+        std::array<SvfCoefficients, numPeakBands> packed;
+        FastDesign::designPeakSvfs(bands, sampleRate, packed, numActive);
+        
+        for (size_t i = 0; i < numActive; ++i)
+            coefficients[bandIndex[i]] = packed[i];
+    }
+    else
+    {
+        for (size_t band = 0; band < numPeakBands; ++band)
+        {
+            const auto& peak = chainSettings.peaks[band];
+            
+            if (peak.isOn)
+                coefficients[band] = makeSvfPeakFilter(peak.freq, peak.quality, peak.gainInDecibels, sampleRate);
+        }
+    }
+    
+    return coefficients;
+}
+
+//the coefficient objects of every stage in chain order, cut filter sections included.
+static std::array<Coefficients*, 8 + numPeakBands> getStageCoefficients(MonoChain& chain)
+{
+    auto& highPass = chain.get<ChainPositions::highPass>();
+    auto& lowPass = chain.get<ChainPositions::lowPass>();
+    
+    std::array<Coefficients*, 8 + numPeakBands> stages
+    {
+        &highPass.get<0>().coefficients, &highPass.get<1>().coefficients, &highPass.get<2>().coefficients, &highPass.get<3>().coefficients
+    };
+    
+    forEachPeakFilter(chain, [&stages](size_t band, Filter& filter) { stages[4 + band] = &filter.coefficients; });
+    
+    stages[4 + numPeakBands] = &lowPass.get<0>().coefficients;
+    stages[5 + numPeakBands] = &lowPass.get<1>().coefficients;
+    stages[6 + numPeakBands] = &lowPass.get<2>().coefficients;
+    stages[7 + numPeakBands] = &lowPass.get<3>().coefficients;
+    
+    return stages;
+}
+
+static void referenceCoefficients(const std::array<Coefficients*, 8 + numPeakBands>& source, MonoChain& chain)
+{
+    auto stages = getStageCoefficients(chain);
+    
+    for (size_t stage = 0; stage < stages.size(); ++stage)
+        *stages[stage] = *source[stage];
+}
+
+void shareCoefficients(juce::OwnedArray<MonoChain>& chains)
+{
+    if (chains.isEmpty())
+        return;
+    
+    //every stage starts as a second order passthrough, so prepare() sizes the filter state for a biquad and the first designed coefficients never make a filter reallocate on the audio thread.
+    auto source = getStageCoefficients(*chains.getFirst());
+    
+    for (auto* coefficients : source)
+        updateCoefficients(*coefficients, FastDesign::BiquadCoefficients { 1.f, 0.f, 0.f, 0.f, 0.f });
+    
+    //the other channels drop their own coefficient objects and reference the first chain's. designs are only written into the first chain, the others just take its bypass flags.
+    for (int channel = 1; channel < chains.size(); channel++)
+        referenceCoefficients(source, *chains.getUnchecked(channel));
+}
+
+void addSharedChains(juce::OwnedArray<MonoChain>& chains, int numChains)
+{
+    if (chains.isEmpty())
+        return;
+    
+    auto source = getStageCoefficients(*chains.getFirst());
+    
+    while (chains.size() < numChains)
+    {
+        auto* chain = chains.add(new MonoChain());
+        referenceCoefficients(source, *chain);
+        copyBypassFlags(*chains.getFirst(), *chain);
+    }
+}
+
+template <typename CutType>
+static void copyCutBypassFlags(const CutType& source, CutType& destination)
+{
+    destination.template setBypassed<0>(source.template isBypassed<0>());
+    destination.template setBypassed<1>(source.template isBypassed<1>());
+    destination.template setBypassed<2>(source.template isBypassed<2>());
+    destination.template setBypassed<3>(source.template isBypassed<3>());
+}
+
+void copyBypassFlags(const MonoChain& source, MonoChain& destination)
+{
+    copyCutBypassFlags(source.get<ChainPositions::highPass>(), destination.get<ChainPositions::highPass>());
+    copyCutBypassFlags(source.get<ChainPositions::lowPass>(), destination.get<ChainPositions::lowPass>());
+    
+    for (size_t band = 0; band < numPeakBands; ++band)
+        setPeakBypassed(destination, band, isPeakBypassed(source, band));
+}
+
+static ChainResponse::Section getSection(const Filter& stage)
+{
+    const auto& raw = stage.coefficients->coefficients;
+    
+    if (raw.size() == 5)
+        return { raw[0], raw[1], raw[2], raw[3], raw[4] };
+    
+    //first order (b0, b1, a1) mapped onto the second order layout.
+    if (raw.size() == 3)
+        return { raw[0], raw[1], 0.f, raw[2], 0.f };
+    
+    return { 1.f, 0.f, 0.f, 0.f, 0.f };
+}
+
+static ChainResponse::Section getSection(const SvfFilter& stage)
+{
+    return getBiquadEquivalent(stage.coefficients);
+}
+
+template <typename CutType>
+static void captureCut(const CutType& cut, ChainResponse& response)
+{
+    if (! cut.template isBypassed<0>()) response.add(getSection(cut.template get<0>()));
+    if (! cut.template isBypassed<1>()) response.add(getSection(cut.template get<1>()));
+    if (! cut.template isBypassed<2>()) response.add(getSection(cut.template get<2>()));
+    if (! cut.template isBypassed<3>()) response.add(getSection(cut.template get<3>()));
+}
+
+template <typename ChainType>
+static void captureChain(const ChainType& chain, double sampleRate, ChainResponse& response)
+{
+    response.sampleRate = sampleRate;
+    response.numStages = 0;
+    
+    if (! chain.template isBypassed<ChainPositions::highPass>())
+        captureCut(chain.template get<ChainPositions::highPass>(), response);
+    
+    forEachPeakFilter(chain, [&](size_t band, const auto& stage)
+    {
+        if (! isPeakBypassed(chain, band))
+            response.add(getSection(stage));
+    });
+    
+    if (! chain.template isBypassed<ChainPositions::lowPass>())
+        captureCut(chain.template get<ChainPositions::lowPass>(), response);
+}
+
+void captureResponse(const MonoChain& chain, double sampleRate, ChainResponse& response)
+{
+    captureChain(chain, sampleRate, response);
+}
+
+void captureResponse(const SvfMonoChain& chain, double sampleRate, ChainResponse& response)
+{
+    captureChain(chain, sampleRate, response);
+}
+
+void updateMonoChain(MonoChain& chain, const ChainSettings& chainSettings, double sampleRate)
+{
+    if (chainSettings.design == CoefficientDesign::Design_Fast)
+    {
+        updatePeakFilters(chain, makeFastPeakFilters(chainSettings, sampleRate), chainSettings);
+        updatePassFilter(chain.get<ChainPositions::highPass>(), FastDesign::designButterworthBiquads(chainSettings.highPassFreq, sampleRate, chainSettings.highPassSlope, true), chainSettings.highPassSlope);
+        updatePassFilter(chain.get<ChainPositions::lowPass>(), FastDesign::designButterworthBiquads(chainSettings.lowPassFreq, sampleRate, chainSettings.lowPassSlope, false), chainSettings.lowPassSlope);
+        return;
+    }
+    
+    updatePeakFilters(chain, makePeakFilters(chainSettings, sampleRate), chainSettings);
+    
+    updatePassFilter(chain.get<ChainPositions::highPass>(), makeHighPassFilter(chainSettings, sampleRate), chainSettings.highPassSlope);
+    updatePassFilter(chain.get<ChainPositions::lowPass>(), makeLowPassFilter(chainSettings, sampleRate), chainSettings.lowPassSlope);
+}
+
+void updateMonoChain(SvfMonoChain& chain, const ChainSettings& chainSettings, double sampleRate)
+{
+    updatePeakFilters(chain, makeSvfPeakFilters(chainSettings, sampleRate), chainSettings);
+    
+    updatePassFilter(chain.get<ChainPositions::highPass>(), makeSvfHighPassFilter(chainSettings, sampleRate), chainSettings.highPassSlope);
+    updatePassFilter(chain.get<ChainPositions::lowPass>(), makeSvfLowPassFilter(chainSettings, sampleRate), chainSettings.lowPassSlope);
+}
+
+//keep in step with the default values of RuckusEQAudioProcessor::createParameterLayout.
+ChainSettings getDefaultChainSettings()
+{
+    ChainSettings settings;
+    
+    settings.highPassFreq = 10.f;
+    settings.lowPassFreq = 21000.f;
+    
+    for (size_t band = 0; band < numPeakBands; ++band)
+    {
+        settings.peaks[band].freq = peakBands[band].defaultFreq;
+        settings.peaks[band].gainInDecibels = 0.f;
+        settings.peaks[band].quality = 1.f;
+        settings.peaks[band].isOn = peakBands[band].isOnByDefault;
+    }
+    
+    return settings;
+}
+
+//keep in step with the parameter ids of createParameterLayout.
+bool applyChainParameter(ChainSettings& settings, const juce::String& parameterID, float value)
+{
+    if (parameterID == "HighPass Freq")      { settings.highPassFreq = value; return true; }
+    if (parameterID == "HighPass Slope")     { settings.highPassSlope = static_cast<Slope>(juce::jlimit(0, 3, juce::roundToInt(value))); return true; }
+    if (parameterID == "LowPass Freq")       { settings.lowPassFreq = value; return true; }
+    if (parameterID == "LowPass Slope")      { settings.lowPassSlope = static_cast<Slope>(juce::jlimit(0, 3, juce::roundToInt(value))); return true; }
+    if (parameterID == "Filter Topology")    { settings.topology = static_cast<FilterTopology>(juce::roundToInt(value)); return true; }
+    if (parameterID == "Coefficient Design") { settings.design = static_cast<CoefficientDesign>(juce::roundToInt(value)); return true; }
+    
+    for (size_t band = 0; band < numPeakBands; ++band)
+    {
+        auto name = juce::String(peakBands[band].name);
+        auto& peak = settings.peaks[band];
+        
+        if (parameterID == name + " Freq") { peak.freq = value; return true; }
+        if (parameterID == name + " Gain") { peak.gainInDecibels = value; return true; }
+        if (parameterID == name + " Q")    { peak.quality = value; return true; }
+        if (parameterID == name + " On")   { peak.isOn = value > 0.5f; return true; }
+    }
+    
+    return false;
+}
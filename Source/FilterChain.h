@@ -0,0 +1,305 @@
+/*
+  ==============================================================================
+
+    FilterChain.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SvfFilter.h"
+#include "FastDesign.h"
+#include "ResponseSnapshot.h"
+
+//the eq's signal path and its coefficient design, without the processor around it. everything here only needs the dsp modules, so the C api library builds from it without the editor or any gui code.
+
+enum Slope
+{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+//which filter structure the processor runs. both give the same magnitude response, svf is cheaper and smoother to modulate.
+enum FilterTopology
+{
+    Topology_Biquad,
+    Topology_Svf
+};
+
+//how coefficients are computed. fast swaps the std trig/pow calls for polynomial approximations, see FastDesign.h for the error bounds.
+enum CoefficientDesign
+{
+    Design_Exact,
+    Design_Fast
+};
+
+//one entry per peak band, in signal order. everything band related is generated from this table: ChainSettings, the chain layout, the parameters and the editor controls. adding a band is one more line here.
+//the parameter ids are the name followed by " Freq", " Gain", " Q" and " On".
+struct PeakBandDescriptor
+{
+    const char* name;
+    float minFreq, maxFreq, freqSkew, defaultFreq;
+    float maxQuality;
+    bool isOnByDefault;
+};
+
+static constexpr PeakBandDescriptor peakBands[]
+{
+    //Rumble 20Hz-200Hz
+    { "Rumble",  20.f,    200.f,   0.9f,  75.f,    3.4f, true },
+    
+    //Lows 150Hz-400Hz
+    { "Low",     150.f,   400.f,   0.85f, 250.f,   3.4f, true },
+    
+    //Low-Mids 0.35kHz-1.5kHz
+    { "LowMid",  350.f,   1500.f,  0.8f,  350.f,   3.4f, true },
+    
+    //High-Mids 1kHz-6kHz
+    { "HighMid", 1000.f,  6000.f,  0.65f, 1000.f,  3.4f, true },
+    
+    //Highs 5kHz-16kHz
+    { "High",    5000.f,  16000.f, 0.5f,  5000.f,  2.f,  true },
+    
+    //Air 14kHz-22kHz
+    { "Air",     14000.f, 22000.f, 0.45f, 14000.f, 1.2f, true }
+};
+
+static constexpr size_t numPeakBands = std::size(peakBands);
+
+//upper bound for the table, the C api's settings struct is sized for it.
+static constexpr size_t maxPeakBands = 16;
+static_assert(numPeakBands > 0 && numPeakBands <= maxPeakBands, "the peak band table must have between 1 and maxPeakBands entries");
+
+struct PeakBandSettings
+{
+    float freq { 0 }, gainInDecibels { 0 }, quality { 1.f };
+    
+    //bands that are off are bypassed and never designed.
+    bool isOn { true };
+};
+
+// extract parameters from audio processor value tree state, create a data structure representing all parameter values.
+struct ChainSettings
+{
+    //one entry per row of peakBands
+    std::array<PeakBandSettings, numPeakBands> peaks;
+    
+    float highPassFreq { 0 }, lowPassFreq { 0 };
+    Slope highPassSlope { Slope::Slope_12 }, lowPassSlope { Slope::Slope_12 };
+    
+    FilterTopology topology { FilterTopology::Topology_Biquad };
+    CoefficientDesign design { CoefficientDesign::Design_Exact };
+};
+
+//mid/side mode gives the side signal its own copy of the cut and band parameters, under the same ids with this in front. topology and design are shared by both.
+static constexpr const char* sideParameterPrefix = "Side ";
+
+
+//create Filter type alias to make code cleaner
+//filter has a response of 12 dB/Oct when it's configured as a HPF or LPF
+using Filter = juce::dsp::IIR::Filter<float>;
+
+//to do dsp in juce we need to create a series of processing, defined as a processing chain, and then pass a context through it.
+//if we use four 12 dB/Oct filters, we can create a 48 dB/Oct filter.
+using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
+
+//expands to ProcessorChain<Cut, Peak, ... one Peak per band ..., Cut>.
+template <size_t, typename Type>
+struct RepeatType
+{
+    using type = Type;
+};
+
+template <typename Cut, typename Peak, size_t... Index>
+juce::dsp::ProcessorChain<Cut, typename RepeatType<Index, Peak>::type..., Cut> makeChainType(std::index_sequence<Index...>);
+
+template <typename Cut, typename Peak>
+using PeakBandChain = decltype(makeChainType<Cut, Peak>(std::make_index_sequence<numPeakBands>()));
+
+//the entire mono signal path is HPF -> one peak filter per band -> LPF
+using MonoChain = PeakBandChain<CutFilter, Filter>;
+
+//same layout built from svf stages.
+using SvfMonoChain = PeakBandChain<SvfCutFilter, SvfFilter>;
+
+enum ChainPositions
+{
+    highPass,
+    firstPeak,
+    lowPass = firstPeak + static_cast<int>(numPeakBands)
+};
+
+//the chain needs stage indices at compile time, most callers only know the band at runtime. these bridge the two.
+//calls function(band, filter) for the peak filter of every band, in signal order.
+template <typename ChainType, typename Function, size_t... Index>
+void forEachPeakFilter(ChainType& chain, Function&& function, std::index_sequence<Index...>)
+{
+    (function(Index, chain.template get<ChainPositions::firstPeak + static_cast<int>(Index)>()), ...);
+}
+
+template <typename ChainType, typename Function>
+void forEachPeakFilter(ChainType& chain, Function&& function)
+{
+    forEachPeakFilter(chain, function, std::make_index_sequence<numPeakBands>());
+}
+
+template <typename ChainType, size_t... Index>
+void setPeakBypassed(ChainType& chain, size_t band, bool shouldBeBypassed, std::index_sequence<Index...>)
+{
+    ((Index == band ? chain.template setBypassed<ChainPositions::firstPeak + static_cast<int>(Index)>(shouldBeBypassed) : void()), ...);
+}
+
+template <typename ChainType>
+void setPeakBypassed(ChainType& chain, size_t band, bool shouldBeBypassed)
+{
+    setPeakBypassed(chain, band, shouldBeBypassed, std::make_index_sequence<numPeakBands>());
+}
+
+template <typename ChainType, size_t... Index>
+bool isPeakBypassed(const ChainType& chain, size_t band, std::index_sequence<Index...>)
+{
+    auto bypassed = false;
+    ((Index == band ? (void) (bypassed = chain.template isBypassed<ChainPositions::firstPeak + static_cast<int>(Index)>()) : void()), ...);
+    return bypassed;
+}
+
+template <typename ChainType>
+bool isPeakBypassed(const ChainType& chain, size_t band)
+{
+    return isPeakBypassed(chain, band, std::make_index_sequence<numPeakBands>());
+}
+
+using Coefficients = Filter::CoefficientsPtr;
+void updateCoefficients(Coefficients& old, const Coefficients& replacements);
+
+Coefficients makePeakFilter(const PeakBandSettings& band, double sampleRate);
+
+template<int index, typename ChainType, typename CoefficientType>
+void update(ChainType& chain, const CoefficientType& coefficients)
+{
+    updateCoefficients(chain.template get<index>().coefficients, coefficients[index]);
+    chain.template setBypassed<index>(false);
+}
+
+template<typename ChainType, typename CoefficientType>
+void updatePassFilter(ChainType& chain, const CoefficientType& coefficients, const Slope& slope)
+{
+    chain.template setBypassed<0>(true);
+    chain.template setBypassed<1>(true);
+    chain.template setBypassed<2>(true);
+    chain.template setBypassed<3>(true);
+    
+    switch(slope)
+    {
+        case Slope_48:
+        {
+            update<3>(chain, coefficients);
+        }
+        case Slope_36:
+        {
+            update<2>(chain, coefficients);
+        }
+        case Slope_24:
+        {
+            update<1>(chain, coefficients);
+        }
+        case Slope_12:
+        {
+            update<0>(chain, coefficients);
+        }
+    }
+}
+
+//since we're using this function in both pluginProcessor and pluginEditor, use inline keyword. otherwise compiler will create a definition for this function everywhere the header file is included and the linker will not know which compiled cpp file to use for the definition.
+inline auto makeHighPassFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.highPassFreq, sampleRate, 2*(chainSettings.highPassSlope + 1));
+}
+
+inline auto makeLowPassFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.lowPassFreq, sampleRate, 2*(chainSettings.lowPassSlope + 1));
+}
+
+//svf versions of the cut filters. every section of a butterworth cascade shares the same cutoff, so the whole design costs one tan().
+using SvfCutCoefficients = std::array<SvfCoefficients, 4>;
+
+inline SvfCutCoefficients makeSvfHighPassFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    SvfCutCoefficients coefficients;
+    auto g = chainSettings.design == CoefficientDesign::Design_Fast ? FastDesign::svfPrewarp(chainSettings.highPassFreq, sampleRate)
+                                                                    : svfPrewarp(chainSettings.highPassFreq, sampleRate);
+    
+    for (int i = 0; i <= chainSettings.highPassSlope; i++)
+        coefficients[i] = makeSvfHighPass(g, butterworthDamping[chainSettings.highPassSlope][i]);
+    
+    return coefficients;
+}
+
+inline SvfCutCoefficients makeSvfLowPassFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    SvfCutCoefficients coefficients;
+    auto g = chainSettings.design == CoefficientDesign::Design_Fast ? FastDesign::svfPrewarp(chainSettings.lowPassFreq, sampleRate)
+                                                                    : svfPrewarp(chainSettings.lowPassFreq, sampleRate);
+    
+    for (int i = 0; i <= chainSettings.lowPassSlope; i++)
+        coefficients[i] = makeSvfLowPass(g, butterworthDamping[chainSettings.lowPassSlope][i]);
+    
+    return coefficients;
+}
+
+SvfCoefficients makeSvfPeakFilter(float freq, float quality, float gainInDecibels, double sampleRate);
+
+//every peak band at once, in chain order. bands that are off are skipped and leave their entry empty. makePeakFilters is the exact biquad design, makeSvfPeakFilters honours chainSettings.design, makeFastPeakFilters is the biquad fast path.
+std::array<Coefficients, numPeakBands> makePeakFilters(const ChainSettings& chainSettings, double sampleRate);
+std::array<FastDesign::BiquadCoefficients, numPeakBands> makeFastPeakFilters(const ChainSettings& chainSettings, double sampleRate);
+std::array<SvfCoefficients, numPeakBands> makeSvfPeakFilters(const ChainSettings& chainSettings, double sampleRate);
+
+//loads the bands that are on and bypasses the ones that are off, so they cost nothing in process().
+template<typename ChainType, typename CoefficientType>
+void updatePeakFilters(ChainType& chain, const CoefficientType& coefficients, const ChainSettings& chainSettings)
+{
+    forEachPeakFilter(chain, [&](size_t band, auto& filter)
+    {
+        if (chainSettings.peaks[band].isOn)
+            updateCoefficients(filter.coefficients, coefficients[band]);
+    });
+    
+    for (size_t band = 0; band < numPeakBands; ++band)
+        setPeakBypassed(chain, band, ! chainSettings.peaks[band].isOn);
+}
+
+//design every stage for the given settings and load it into a single chain. used by code that owns a chain outside of the processor.
+void updateMonoChain(MonoChain& chain, const ChainSettings& chainSettings, double sampleRate);
+void updateMonoChain(SvfMonoChain& chain, const ChainSettings& chainSettings, double sampleRate);
+
+//which stages run is the only thing chains with shared coefficients don't have in common. copies them from the chain the designs were written into.
+void copyBypassFlags(const MonoChain& source, MonoChain& destination);
+
+//points every chain at the first chain's coefficient objects, for a set of chains that always run the same eq. call before prepare().
+void shareCoefficients(juce::OwnedArray<MonoChain>& chains);
+
+//adds chains until there are numChains, each referencing the first chain's coefficient objects and taking its bypass flags, so whatever was designed into the first chain runs on all of them without designing it again. call after shareCoefficients and before prepare().
+void addSharedChains(juce::OwnedArray<MonoChain>& chains, int numChains);
+
+//every stage a chain can run: four sections per cut filter plus one per peak band.
+static constexpr size_t maxChainStages = 8 + numPeakBands;
+
+using ChainResponse = ResponseSnapshot<maxChainStages>;
+using PublishedChainResponse = PublishedResponse<maxChainStages>;
+
+//the stages of a chain that aren't bypassed, as biquad sections. svf stages are converted to the equivalent biquad, so both topologies draw through the same path.
+void captureResponse(const MonoChain& chain, double sampleRate, ChainResponse& response);
+void captureResponse(const SvfMonoChain& chain, double sampleRate, ChainResponse& response);
+
+//the parameter defaults of createParameterLayout, for code that runs a chain without an apvts.
+ChainSettings getDefaultChainSettings();
+
+//sets the ChainSettings field a parameter id from createParameterLayout maps to, for code that rebuilds the settings from a saved state instead of an apvts. returns false for ids that don't affect the chain, the side set included.
+bool applyChainParameter(ChainSettings& settings, const juce::String& parameterID, float value);
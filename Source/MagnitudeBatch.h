@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    MagnitudeBatch.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//evaluates biquad magnitude responses over a whole set of frequencies at once. the trig terms of every frequency are computed once in prepare(), after that a section costs a few multiply-adds per frequency with no trig or complex maths, which is what the response curve and the match eq fitting need.
+struct MagnitudeGrid
+{
+    void prepare(const std::vector<double>& gridFrequencies, double newSampleRate)
+    {
+        frequencies = gridFrequencies;
+        sampleRate = newSampleRate;
+
+        auto size = frequencies.size();
+        cosW.resize(size); sinW.resize(size); cos2W.resize(size); sin2W.resize(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto w = juce::MathConstants<double>::twoPi * frequencies[i] / sampleRate;
+            cosW[i] = std::cos(w);
+            sinW[i] = std::sin(w);
+            cos2W[i] = std::cos(2.0 * w);
+            sin2W[i] = std::sin(2.0 * w);
+        }
+    }
+
+    size_t size() const noexcept { return frequencies.size(); }
+
+    //multiplies the squared magnitude of one normalised section (b0, b1, b2, a1, a2) into every entry of power.
+    void multiplyPower(const float* coefficients, double* power) const noexcept
+    {
+        const double b0 = coefficients[0], b1 = coefficients[1], b2 = coefficients[2], a1 = coefficients[3], a2 = coefficients[4];
+
+        for (size_t i = 0; i < frequencies.size(); ++i)
+        {
+            auto numRe = b0 + b1 * cosW[i] + b2 * cos2W[i];
+            auto numIm = b1 * sinW[i] + b2 * sin2W[i];
+            auto denRe = 1.0 + a1 * cosW[i] + a2 * cos2W[i];
+            auto denIm = a1 * sinW[i] + a2 * sin2W[i];
+
+            power[i] *= (numRe * numRe + numIm * numIm) / (denRe * denRe + denIm * denIm);
+        }
+    }
+
+    //same for a juce coefficients object. the default first order coefficients (b0, b1, a1) are mapped onto the second order layout.
+    void multiplyPower(const juce::dsp::IIR::Coefficients<float>& coefficients, double* power) const noexcept
+    {
+        auto* raw = coefficients.coefficients.begin();
+
+        if (coefficients.coefficients.size() == 5)
+        {
+            multiplyPower(raw, power);
+        }
+        else if (coefficients.coefficients.size() == 3)
+        {
+            const float firstOrder[] { raw[0], raw[1], 0.f, raw[2], 0.f };
+            multiplyPower(firstOrder, power);
+        }
+    }
+
+    static void powerToDecibels(const double* power, float* decibels, size_t size) noexcept
+    {
+        for (size_t i = 0; i < size; ++i)
+            decibels[i] = static_cast<float>(10.0 * std::log10(juce::jmax(power[i], 1.0e-30)));
+    }
+
+    std::vector<double> frequencies;
+    double sampleRate { 0.0 };
+
+private:
+    std::vector<double> cosW, sinW, cos2W, sin2W;
+};
+
+//the curve the editor draws: numPoints frequencies spread evenly in log from 20 Hz to 22 kHz, every stage of a ResponseSnapshot multiplied in, in dB. the grid is only rebuilt when the number of points or the sample rate changes.
+//the response curve and the preset thumbnails both come from here, so a thumbnail is exactly what the editor would show for that preset.
+template <typename Snapshot>
+void computeResponseCurve(const Snapshot& response, size_t numPoints, MagnitudeGrid& grid, std::vector<double>& power, std::vector<float>& decibels)
+{
+    if (grid.size() != numPoints || grid.sampleRate != response.sampleRate)
+    {
+        std::vector<double> frequencies(numPoints);
+
+        for (size_t i = 0; i < numPoints; ++i)
+            frequencies[i] = juce::mapToLog10(static_cast<double>(i) / static_cast<double>(numPoints), 20.0, 22000.0);
+
+        grid.prepare(frequencies, response.sampleRate);
+    }
+
+    power.assign(numPoints, 1.0);
+    decibels.resize(numPoints);
+
+    //the snapshot only holds stages that aren't bypassed.
+    for (size_t stage = 0; stage < response.numStages; ++stage)
+        grid.multiplyPower(response.stages[stage].data(), power.data());
+
+    MagnitudeGrid::powerToDecibels(power.data(), decibels.data(), numPoints);
+}
@@ -0,0 +1,596 @@
+/*
+  ==============================================================================
+
+    MatchEQ.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "MatchEQ.h"
+
+//analysis grid resolution, about 13 points per octave.
+static constexpr int numGridPoints = 128;
+
+//search resolution of the fit. with these a full fit evaluates roughly 80k candidate sections on the grid, which should take about a quarter of a second on one desktop core. the benchmark's --match-fit times it against that budget.
+static constexpr int numPeakFrequencies = 16;
+static constexpr int numPeakQualities = 6;
+static constexpr int numGainSteps = 14;
+static constexpr int numCutFrequencies = 24;
+static constexpr int numRefinements = 40;
+static constexpr int numFitPasses = 4;
+
+void SpectrumAverager::reset(double newSampleRate)
+{
+    if (fft == nullptr)
+    {
+        fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+        window = std::make_unique<juce::dsp::WindowingFunction<float>>(static_cast<size_t>(fftSize), juce::dsp::WindowingFunction<float>::hann, false);
+        fifo.resize(fftSize);
+        frame.resize(2 * fftSize);
+        powerSum.resize(fftSize / 2 + 1);
+    }
+
+    sampleRate = newSampleRate;
+    std::fill(powerSum.begin(), powerSum.end(), 0.0);
+    fifoIndex = 0;
+    numFrames = 0;
+}
+
+void SpectrumAverager::push(const float* samples, int numSamples)
+{
+    while (numSamples > 0)
+    {
+        auto numToCopy = juce::jmin(numSamples, fftSize - fifoIndex);
+        std::copy(samples, samples + numToCopy, fifo.begin() + fifoIndex);
+
+        samples += numToCopy;
+        numSamples -= numToCopy;
+        fifoIndex += numToCopy;
+
+        if (fifoIndex == fftSize)
+        {
+            processFrame();
+
+            //50% overlap: keep the second half as the start of the next frame.
+            std::copy(fifo.begin() + fftSize / 2, fifo.end(), fifo.begin());
+            fifoIndex = fftSize / 2;
+        }
+    }
+}
+
+void SpectrumAverager::processFrame()
+{
+    std::copy(fifo.begin(), fifo.end(), frame.begin());
+    std::fill(frame.begin() + fftSize, frame.end(), 0.f);
+
+    window->multiplyWithWindowingTable(frame.data(), static_cast<size_t>(fftSize));
+    fft->performFrequencyOnlyForwardTransform(frame.data());
+
+    for (size_t bin = 0; bin < powerSum.size(); ++bin)
+        powerSum[bin] += static_cast<double>(frame[bin]) * frame[bin];
+
+    ++numFrames;
+}
+
+std::vector<float> SpectrumAverager::getAverageDecibels(const std::vector<double>& gridFrequencies) const
+{
+    std::vector<float> decibels(gridFrequencies.size(), -100.f);
+
+    if (numFrames == 0)
+        return decibels;
+
+    auto binWidth = sampleRate / fftSize;
+    auto lastBin = static_cast<int>(powerSum.size()) - 1;
+
+    //every grid point averages the bins within +-1/24 octave, and at least the nearest one where the bins are wider than that.
+    auto halfBandwidth = std::pow(2.0, 1.0 / 24.0);
+
+    for (size_t i = 0; i < gridFrequencies.size(); ++i)
+    {
+        auto lowBin = juce::jlimit(1, lastBin, static_cast<int>(std::ceil(gridFrequencies[i] / halfBandwidth / binWidth)));
+        auto highBin = juce::jlimit(1, lastBin, static_cast<int>(std::floor(gridFrequencies[i] * halfBandwidth / binWidth)));
+
+        if (highBin < lowBin)
+            lowBin = highBin = juce::jlimit(1, lastBin, juce::roundToInt(gridFrequencies[i] / binWidth));
+
+        double sum = 0.0;
+        for (int bin = lowBin; bin <= highBin; ++bin)
+            sum += powerSum[static_cast<size_t>(bin)];
+
+        auto meanPower = sum / (numFrames * (highBin - lowBin + 1));
+        decibels[i] = static_cast<float>(10.0 * std::log10(juce::jmax(meanPower, 1.0e-20)));
+    }
+
+    return decibels;
+}
+
+//==============================================================================
+MatchEQ::MatchEQ(juce::AudioProcessorValueTreeState& state)
+    : juce::Thread("RuckusEQ match eq"),
+      apvts(state)
+{
+}
+
+MatchEQ::~MatchEQ()
+{
+    cancelPendingUpdate();
+    stopThread(2000);
+}
+
+void MatchEQ::prepare(double sampleRate)
+{
+    //the analysis thread restarts the input average when it sees the new rate, the audio thread never touches the spectrum itself.
+    inputSampleRate = sampleRate;
+    inputSampleRateChanged = true;
+}
+
+void MatchEQ::pushInput(const juce::AudioBuffer<float>& buffer, int numInputChannels) noexcept
+{
+    if (! learning.load() || numInputChannels <= 0)
+        return;
+
+    auto numChannels = juce::jmin(numInputChannels, buffer.getNumChannels());
+    auto channelGain = 1.f / static_cast<float>(numChannels);
+
+    //anything that doesn't fit is dropped, a few missing blocks don't change a long term average.
+    int start1, size1, start2, size2;
+    inputFifo.prepareToWrite(buffer.getNumSamples(), start1, size1, start2, size2);
+
+    auto writeMonoSum = [&](int destination, int source, int numSamples)
+    {
+        auto* out = inputFifoBuffer.data() + destination;
+        juce::FloatVectorOperations::copyWithMultiply(out, buffer.getReadPointer(0, source), channelGain, numSamples);
+
+        for (int channel = 1; channel < numChannels; channel++)
+            juce::FloatVectorOperations::addWithMultiply(out, buffer.getReadPointer(channel, source), channelGain, numSamples);
+    };
+
+    if (size1 > 0)
+        writeMonoSum(start1, 0, size1);
+
+    if (size2 > 0)
+        writeMonoSum(start2, size1, size2);
+
+    inputFifo.finishedWrite(size1 + size2);
+}
+
+void MatchEQ::loadReference(const juce::File& file)
+{
+    {
+        const juce::ScopedLock sl(pendingLock);
+        pendingReference = file;
+    }
+
+    startIfNeeded();
+    notify();
+}
+
+void MatchEQ::setLearning(bool shouldLearn)
+{
+    //the audio thread only touches the buffer once learning is set, so it has to exist before that. it is never resized afterwards.
+    if (shouldLearn && inputFifoBuffer.empty())
+        inputFifoBuffer.resize(static_cast<size_t>(inputFifo.getTotalSize()));
+
+    if (shouldLearn && ! learning.load())
+        inputResetRequested = true;
+
+    learning = shouldLearn;
+
+    if (shouldLearn)
+    {
+        startIfNeeded();
+        notify();
+    }
+}
+
+void MatchEQ::requestMatch()
+{
+    matchRequested = true;
+    startIfNeeded();
+    notify();
+}
+
+void MatchEQ::startIfNeeded()
+{
+    //most instances never use the match eq, so the thread only exists once it is asked for.
+    if (! isThreadRunning())
+        startThread();
+}
+
+void MatchEQ::run()
+{
+    inputSampleRateChanged = false;
+    inputSpectrum.reset(inputSampleRate.load());
+
+    while (! threadShouldExit())
+    {
+        juce::File reference;
+
+        {
+            const juce::ScopedLock sl(pendingLock);
+            std::swap(reference, pendingReference);
+        }
+
+        if (reference.existsAsFile())
+            analyseReference(reference);
+
+        drainInput();
+
+        if (matchRequested.exchange(false))
+        {
+            //pick up whatever the audio thread pushed since the last drain.
+            drainInput();
+            match();
+        }
+
+        //while learning, wake up often enough that the fifo never fills.
+        wait(learning.load() ? 20 : -1);
+    }
+}
+
+void MatchEQ::analyseReference(const juce::File& file)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+    if (reader == nullptr || reader->numChannels == 0)
+        return;
+
+    referenceSpectrum.reset(reader->sampleRate);
+
+    constexpr int chunkSize = 8192;
+    auto numChannels = static_cast<int>(reader->numChannels);
+    juce::AudioBuffer<float> chunk(numChannels, chunkSize);
+    std::vector<float> mono(chunkSize);
+
+    for (juce::int64 position = 0; position < reader->lengthInSamples && ! threadShouldExit(); position += chunkSize)
+    {
+        auto numSamples = static_cast<int>(juce::jmin<juce::int64>(chunkSize, reader->lengthInSamples - position));
+        reader->read(&chunk, 0, numSamples, position, true, true);
+
+        juce::FloatVectorOperations::copyWithMultiply(mono.data(), chunk.getReadPointer(0), 1.f / numChannels, numSamples);
+        for (int channel = 1; channel < numChannels; channel++)
+            juce::FloatVectorOperations::addWithMultiply(mono.data(), chunk.getReadPointer(channel), 1.f / numChannels, numSamples);
+
+        referenceSpectrum.push(mono.data(), numSamples);
+
+        //keep the input side drained while a long file is being read.
+        drainInput();
+    }
+}
+
+void MatchEQ::drainInput()
+{
+    if (inputSampleRateChanged.exchange(false))
+        inputSpectrum.reset(inputSampleRate.load());
+
+    //a new learning pass also drops whatever was still queued. some of it may belong to the previous pass, and a few blocks of the new one don't change a long term average.
+    if (inputResetRequested.exchange(false))
+    {
+        inputFifo.finishedRead(inputFifo.getNumReady());
+        inputSpectrum.reset(inputSampleRate.load());
+        return;
+    }
+
+    int start1, size1, start2, size2;
+    inputFifo.prepareToRead(inputFifo.getNumReady(), start1, size1, start2, size2);
+
+    if (size1 > 0)
+        inputSpectrum.push(inputFifoBuffer.data() + start1, size1);
+
+    if (size2 > 0)
+        inputSpectrum.push(inputFifoBuffer.data() + start2, size2);
+
+    inputFifo.finishedRead(size1 + size2);
+}
+
+std::vector<double> MatchEQ::makeGridFrequencies()
+{
+    std::vector<double> frequencies(numGridPoints);
+
+    for (int i = 0; i < numGridPoints; ++i)
+        frequencies[static_cast<size_t>(i)] = juce::mapToLog10(static_cast<double>(i) / (numGridPoints - 1), 20.0, 20000.0);
+
+    return frequencies;
+}
+
+void MatchEQ::match()
+{
+    if (! referenceSpectrum.hasData() || ! inputSpectrum.hasData())
+        return;
+
+    auto frequencies = makeGridFrequencies();
+    auto reference = referenceSpectrum.getAverageDecibels(frequencies);
+    auto input = inputSpectrum.getAverageDecibels(frequencies);
+
+    //the eq has no output gain, so only the shape of the difference is matched, not its overall level.
+    std::vector<float> difference(frequencies.size());
+    for (size_t i = 0; i < difference.size(); ++i)
+        difference[i] = reference[i] - input[i];
+
+    auto mean = std::accumulate(difference.begin(), difference.end(), 0.f) / static_cast<float>(difference.size());
+
+    //1/3 octave smoothing, a parametric eq can't follow anything narrower and it keeps the fit from chasing bin noise.
+    const int halfWidth = 2;
+    std::vector<float> target(difference.size());
+
+    for (int i = 0; i < static_cast<int>(target.size()); ++i)
+    {
+        auto first = juce::jmax(0, i - halfWidth);
+        auto last = juce::jmin(static_cast<int>(target.size()) - 1, i + halfWidth);
+        auto sum = std::accumulate(difference.begin() + first, difference.begin() + last + 1, 0.f);
+
+        target[static_cast<size_t>(i)] = juce::jlimit(-24.f, 24.f, sum / static_cast<float>(last - first + 1) - mean);
+    }
+
+    MagnitudeGrid grid;
+    grid.prepare(frequencies, inputSampleRate.load());
+
+    //start from a flat eq so the result only depends on the two spectra. bands that are switched off stay off and out of the fit.
+    auto start = getChainSettings(apvts);
+
+    for (auto& peak : start.peaks)
+        peak.gainInDecibels = 0.f;
+
+    start.highPassFreq = apvts.getParameterRange("HighPass Freq").start;
+    start.lowPassFreq = apvts.getParameterRange("LowPass Freq").end;
+    start.highPassSlope = start.lowPassSlope = Slope::Slope_12;
+
+    auto result = fit(target, grid, apvts, start);
+
+    {
+        const juce::ScopedLock sl(pendingLock);
+        pendingResult = result;
+    }
+
+    triggerAsyncUpdate();
+}
+
+ChainSettings MatchEQ::fit(const std::vector<float>& targetDecibels, const MagnitudeGrid& grid, juce::AudioProcessorValueTreeState& apvts, ChainSettings settings)
+{
+    auto size = grid.size();
+    auto sampleRate = grid.sampleRate;
+
+    //dB response of every stage on the grid: highpass, one per peak band, lowpass. bands that are off stay at 0 dB. a candidate for one stage is scored against the sum of all the others, so only that stage has to be evaluated.
+    constexpr size_t highPassStage = 0, lowPassStage = numPeakBands + 1;
+    std::array<std::vector<float>, numPeakBands + 2> stages;
+
+    std::vector<double> power(size);
+    std::vector<float> candidate(size), rest(size);
+
+    auto evaluate = [&](const FastDesign::BiquadCoefficients* sections, int numSections, std::vector<float>& decibels)
+    {
+        std::fill(power.begin(), power.end(), 1.0);
+
+        for (int i = 0; i < numSections; ++i)
+            grid.multiplyPower(sections[i].data(), power.data());
+
+        MagnitudeGrid::powerToDecibels(power.data(), decibels.data(), size);
+    };
+
+    auto evaluatePeak = [&](float freq, float quality, float gainInDecibels, std::vector<float>& decibels)
+    {
+        FastDesign::PeakBands<1> band;
+        band.freq = { freq };
+        band.quality = { quality };
+        band.gainInDecibels = { gainInDecibels };
+
+        std::array<FastDesign::BiquadCoefficients, 1> coefficients;
+        FastDesign::designPeakBiquads(band, sampleRate, coefficients);
+        evaluate(coefficients.data(), 1, decibels);
+    };
+
+    auto evaluateCut = [&](float freq, int slope, bool isHighPass, std::vector<float>& decibels)
+    {
+        auto coefficients = FastDesign::designButterworthBiquads(freq, sampleRate, slope, isHighPass);
+        evaluate(coefficients.data(), slope + 1, decibels);
+    };
+
+    auto excludeStage = [&](size_t excluded)
+    {
+        std::fill(rest.begin(), rest.end(), 0.f);
+
+        for (size_t stage = 0; stage < stages.size(); ++stage)
+            if (stage != excluded)
+                juce::FloatVectorOperations::add(rest.data(), stages[stage].data(), static_cast<int>(size));
+    };
+
+    auto error = [&](const std::vector<float>& decibels)
+    {
+        double sum = 0.0;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto difference = static_cast<double>(rest[i] + decibels[i] - targetDecibels[i]);
+            sum += difference * difference;
+        }
+
+        return sum;
+    };
+
+    for (auto& stage : stages)
+        stage.resize(size);
+
+    evaluateCut(settings.highPassFreq, settings.highPassSlope, true, stages[highPassStage]);
+    evaluateCut(settings.lowPassFreq, settings.lowPassSlope, false, stages[lowPassStage]);
+
+    for (size_t band = 0; band < numPeakBands; ++band)
+    {
+        const auto& peak = settings.peaks[band];
+
+        if (peak.isOn)
+            evaluatePeak(peak.freq, peak.quality, peak.gainInDecibels, stages[band + 1]);
+    }
+
+    //cut filters: exhaustive search over frequency and slope.
+    auto fitCut = [&](size_t stage, const juce::String& parameterName, bool isHighPass, float& freq, Slope& slope)
+    {
+        auto range = apvts.getParameterRange(parameterName + " Freq");
+
+        excludeStage(stage);
+        auto bestError = error(stages[stage]);
+
+        for (int i = 0; i < numCutFrequencies; ++i)
+        {
+            auto candidateFreq = range.snapToLegalValue(juce::mapToLog10(static_cast<float>(i) / (numCutFrequencies - 1), range.start, range.end));
+
+            for (int candidateSlope = Slope::Slope_12; candidateSlope <= Slope::Slope_48; ++candidateSlope)
+            {
+                evaluateCut(candidateFreq, candidateSlope, isHighPass, candidate);
+                auto candidateError = error(candidate);
+
+                if (candidateError < bestError)
+                {
+                    bestError = candidateError;
+                    freq = candidateFreq;
+                    slope = static_cast<Slope>(candidateSlope);
+                    stages[stage].swap(candidate);
+                }
+            }
+        }
+    };
+
+    //peak bands: coarse grid over frequency and Q with a golden section search over gain at each point, then a pattern search around the best point to get off the grid.
+    auto fitPeak = [&](size_t band)
+    {
+        juce::String name(peakBands[band].name);
+        auto& peak = settings.peaks[band];
+        auto freqRange = apvts.getParameterRange(name + " Freq");
+        auto gainRange = apvts.getParameterRange(name + " Gain");
+        auto qualityRange = apvts.getParameterRange(name + " Q");
+
+        excludeStage(band + 1);
+        auto bestError = error(stages[band + 1]);
+
+        auto tryPeak = [&](float freq, float quality, float gain)
+        {
+            freq = freqRange.snapToLegalValue(freq);
+            quality = qualityRange.snapToLegalValue(quality);
+            gain = gainRange.snapToLegalValue(gain);
+
+            evaluatePeak(freq, quality, gain, candidate);
+            auto candidateError = error(candidate);
+
+            if (candidateError >= bestError)
+                return false;
+
+            bestError = candidateError;
+            peak.freq = freq;
+            peak.quality = quality;
+            peak.gainInDecibels = gain;
+            stages[band + 1].swap(candidate);
+            return true;
+        };
+
+        constexpr float goldenRatio = 0.618034f;
+
+        for (int i = 0; i < numPeakFrequencies; ++i)
+        {
+            auto freq = juce::mapToLog10(static_cast<float>(i) / (numPeakFrequencies - 1), freqRange.start, freqRange.end);
+
+            for (int j = 0; j < numPeakQualities; ++j)
+            {
+                auto quality = juce::mapToLog10(static_cast<float>(j) / (numPeakQualities - 1), qualityRange.start, qualityRange.end);
+
+                auto errorForGain = [&](float gain)
+                {
+                    evaluatePeak(freq, quality, gain, candidate);
+                    return error(candidate);
+                };
+
+                auto low = gainRange.start, high = gainRange.end;
+
+                for (int step = 0; step < numGainSteps; ++step)
+                {
+                    auto a = high - goldenRatio * (high - low);
+                    auto b = low + goldenRatio * (high - low);
+
+                    if (errorForGain(a) < errorForGain(b))
+                        high = b;
+                    else
+                        low = a;
+                }
+
+                tryPeak(freq, quality, 0.5f * (low + high));
+            }
+        }
+
+        //steps start at half the grid spacing and halve whenever no neighbour improves.
+        auto freqStep = std::pow(freqRange.end / freqRange.start, 0.5f / (numPeakFrequencies - 1));
+        auto qualityStep = std::pow(qualityRange.end / qualityRange.start, 0.5f / (numPeakQualities - 1));
+        auto gainStep = 2.f;
+
+        for (int refinement = 0; refinement < numRefinements; ++refinement)
+        {
+            auto freq = peak.freq, quality = peak.quality, gain = peak.gainInDecibels;
+
+            auto improved = tryPeak(freq * freqStep, quality, gain) || tryPeak(freq / freqStep, quality, gain)
+                         || tryPeak(freq, quality * qualityStep, gain) || tryPeak(freq, quality / qualityStep, gain)
+                         || tryPeak(freq, quality, gain + gainStep) || tryPeak(freq, quality, gain - gainStep);
+
+            if (! improved)
+            {
+                freqStep = std::sqrt(freqStep);
+                qualityStep = std::sqrt(qualityStep);
+                gainStep *= 0.5f;
+            }
+        }
+    };
+
+    //coordinate descent, a few passes let the bands settle against each other.
+    for (int pass = 0; pass < numFitPasses; ++pass)
+    {
+        for (size_t band = 0; band < numPeakBands; ++band)
+            if (settings.peaks[band].isOn)
+                fitPeak(band);
+
+        //the cuts go last, fitted first they would swallow low and high shelving that the outer peak bands match better.
+        fitCut(highPassStage, "HighPass", true, settings.highPassFreq, settings.highPassSlope);
+        fitCut(lowPassStage, "LowPass", false, settings.lowPassFreq, settings.lowPassSlope);
+    }
+
+    return settings;
+}
+
+void MatchEQ::handleAsyncUpdate()
+{
+    ChainSettings result;
+
+    {
+        const juce::ScopedLock sl(pendingLock);
+        result = pendingResult;
+    }
+
+    //written as gestures so hosts record the match as a single automatable edit per parameter.
+    auto setParameter = [this](const juce::String& parameterID, float value)
+    {
+        if (auto* parameter = apvts.getParameter(parameterID))
+        {
+            parameter->beginChangeGesture();
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+            parameter->endChangeGesture();
+        }
+    };
+
+    setParameter("HighPass Freq", result.highPassFreq);
+    setParameter("HighPass Slope", static_cast<float>(result.highPassSlope));
+    setParameter("LowPass Freq", result.lowPassFreq);
+    setParameter("LowPass Slope", static_cast<float>(result.lowPassSlope));
+
+    for (size_t band = 0; band < numPeakBands; ++band)
+    {
+        const auto& peak = result.peaks[band];
+
+        if (! peak.isOn)
+            continue;
+
+        juce::String name(peakBands[band].name);
+        setParameter(name + " Freq", peak.freq);
+        setParameter(name + " Gain", peak.gainInDecibels);
+        setParameter(name + " Q", peak.quality);
+    }
+}
@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    MatchEQ.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "MagnitudeBatch.h"
+
+//long term average spectrum. frames are hann windowed with 50% overlap and their power is summed per fft bin, so any amount of audio can be streamed through it in constant memory.
+//nothing is allocated until the first reset(), so instances that never use the match eq don't carry the fft tables around.
+class SpectrumAverager
+{
+public:
+    static constexpr int fftOrder = 12;
+    static constexpr int fftSize = 1 << fftOrder;
+
+    //must be called before the first push().
+    void reset(double newSampleRate);
+    void push(const float* samples, int numSamples);
+
+    bool hasData() const noexcept { return numFrames > 0; }
+
+    //average level in dB around each grid frequency, smoothed over 1/12 octave.
+    std::vector<float> getAverageDecibels(const std::vector<double>& gridFrequencies) const;
+
+private:
+    std::unique_ptr<juce::dsp::FFT> fft;
+    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+
+    std::vector<float> fifo, frame;
+    std::vector<double> powerSum;
+    int fifoIndex { 0 }, numFrames { 0 };
+    double sampleRate { 44100.0 };
+
+    void processFrame();
+};
+
+//match eq: compares the long term spectrum of a reference file with the plugin's input and fits the peak bands that are switched on plus the highpass and lowpass to the difference.
+//all analysis and fitting runs on a background thread, the audio thread only copies its input into a lock-free fifo while learning, and the fitted settings are written into the apvts on the message thread.
+class MatchEQ : private juce::Thread,
+                private juce::AsyncUpdater
+{
+public:
+    explicit MatchEQ(juce::AudioProcessorValueTreeState& apvts);
+    ~MatchEQ() override;
+
+    //audio thread.
+    void prepare(double sampleRate);
+    void pushInput(const juce::AudioBuffer<float>& buffer, int numInputChannels) noexcept;
+
+    //message thread. switching learning on starts a new input average, it doesn't add to the last one.
+    void loadReference(const juce::File& file);
+    void setLearning(bool shouldLearn);
+    bool isLearning() const noexcept { return learning.load(); }
+    void requestMatch();
+
+    //fits the bands to a target curve (dB per grid frequency). exposed separately so it can be driven without audio.
+    static ChainSettings fit(const std::vector<float>& targetDecibels, const MagnitudeGrid& grid, juce::AudioProcessorValueTreeState& apvts, ChainSettings start);
+
+    //log spaced analysis grid, 20 Hz to 20 kHz.
+    static std::vector<double> makeGridFrequencies();
+
+private:
+    juce::AudioProcessorValueTreeState& apvts;
+
+    std::atomic<bool> learning { false }, matchRequested { false };
+    std::atomic<double> inputSampleRate { 44100.0 };
+    std::atomic<bool> inputSampleRateChanged { false };
+
+    //set by setLearning(true), the analysis thread clears the input average when it sees it. only that thread ever touches the spectrum.
+    std::atomic<bool> inputResetRequested { false };
+
+    //mono sum of the input, written by the audio thread and drained by the analysis thread. the buffer is only allocated the first time learning is switched on.
+    juce::AbstractFifo inputFifo { 1 << 17 };
+    std::vector<float> inputFifoBuffer;
+
+    SpectrumAverager referenceSpectrum, inputSpectrum;
+
+    juce::CriticalSection pendingLock;
+    juce::File pendingReference;
+    ChainSettings pendingResult;
+
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    void startIfNeeded();
+    void analyseReference(const juce::File& file);
+    void drainInput();
+    void match();
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MatchEQ)
+};
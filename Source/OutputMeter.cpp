@@ -0,0 +1,354 @@
+/*
+  ==============================================================================
+
+    OutputMeter.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "OutputMeter.h"
+
+namespace
+{
+    //one step of both sections in transposed direct form II, the same recursion the juce filters run.
+    template <typename Type, typename Section>
+    Type stepSections(const Section* sections, Type* state, Type input) noexcept
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            const auto& c = sections[i];
+            auto* s = state + 2 * i;
+
+            auto output = static_cast<Type>(c[0]) * input + s[0];
+            s[0] = static_cast<Type>(c[1]) * input - static_cast<Type>(c[3]) * output + s[1];
+            s[1] = static_cast<Type>(c[2]) * input - static_cast<Type>(c[4]) * output;
+            input = output;
+        }
+
+        return input;
+    }
+
+    //BS.1770 gives the K-weighting as coefficients at 48 kHz. these are the analog prototypes behind them, which reproduce those coefficients exactly at 48 kHz and give the same curve at any other rate.
+    constexpr double shelfFrequency = 1681.974450955533, shelfGainInDecibels = 3.999843853973347, shelfQuality = 0.7071752369554196;
+    constexpr double highPassFrequency = 38.13547087602444, highPassQuality = 0.5003270373238773;
+
+    //loudness of a mean square summed over channels.
+    float toLoudness(double meanSquare) noexcept
+    {
+        if (meanSquare <= 0.0)
+            return OutputMeter::silentLoudness;
+
+        return juce::jmax(OutputMeter::silentLoudness, static_cast<float>(-0.691 + 10.0 * std::log10(meanSquare)));
+    }
+
+    //BS.1770 weights: the surrounds beside the listener count 1.41, the lfe isn't part of the loudness, everything else counts 1.
+    double getLoudnessWeight(juce::AudioChannelSet::ChannelType type) noexcept
+    {
+        switch (type)
+        {
+            case juce::AudioChannelSet::LFE:
+            case juce::AudioChannelSet::LFE2:
+                return 0.0;
+
+            case juce::AudioChannelSet::leftSurround:
+            case juce::AudioChannelSet::rightSurround:
+            case juce::AudioChannelSet::leftSurroundSide:
+            case juce::AudioChannelSet::rightSurroundSide:
+                return 1.41;
+
+            default:
+                return 1.0;
+        }
+    }
+}
+
+std::array<Coefficients, 2> KWeighting::makeFilters(double sampleRate)
+{
+    using CoefficientType = juce::dsp::IIR::Coefficients<float>;
+
+    auto k = std::tan(juce::MathConstants<double>::pi * shelfFrequency / sampleRate);
+    auto highGain = std::pow(10.0, shelfGainInDecibels / 20.0);
+    auto bandGain = std::pow(highGain, 0.4996667741545416);
+
+    auto shelf = new CoefficientType(static_cast<float>(highGain + bandGain * k / shelfQuality + k * k),
+                                     static_cast<float>(2.0 * (k * k - highGain)),
+                                     static_cast<float>(highGain - bandGain * k / shelfQuality + k * k),
+                                     static_cast<float>(1.0 + k / shelfQuality + k * k),
+                                     static_cast<float>(2.0 * (k * k - 1.0)),
+                                     static_cast<float>(1.0 - k / shelfQuality + k * k));
+
+    k = std::tan(juce::MathConstants<double>::pi * highPassFrequency / sampleRate);
+
+    //BS.1770's high pass numerator is 1, -2, 1 as it stands. the constructor divides everything by a0, so it's scaled up by a0 to come out that way.
+    auto highPassA0 = 1.0 + k / highPassQuality + k * k;
+
+    auto highPass = new CoefficientType(static_cast<float>(highPassA0),
+                                        static_cast<float>(-2.0 * highPassA0),
+                                        static_cast<float>(highPassA0),
+                                        static_cast<float>(highPassA0),
+                                        static_cast<float>(2.0 * (k * k - 1.0)),
+                                        static_cast<float>(1.0 - k / highPassQuality + k * k));
+
+    return { Coefficients(shelf), Coefficients(highPass) };
+}
+
+void KWeighting::prepare(double sampleRate)
+{
+    auto filters = makeFilters(sampleRate);
+
+    for (size_t i = 0; i < 2; ++i)
+        std::copy(filters[i]->coefficients.begin(), filters[i]->coefficients.begin() + 5, sections[i].begin());
+
+    //a step is linear in the state and the inputs, so its matrices are the responses to one unit state entry or one unit input at a time. worked out in double, the float matrices are then as close to the exact step as they can be.
+    for (size_t column = 0; column < 4 + stepLength; ++column)
+    {
+        std::array<double, 4> state {};
+        std::array<double, stepLength> inputs {}, outputs {};
+
+        if (column < 4)
+            state[column] = 1.0;
+        else
+            inputs[column - 4] = 1.0;
+
+        for (size_t i = 0; i < stepLength; ++i)
+            outputs[i] = stepSections(sections.data(), state.data(), inputs[i]);
+
+        auto& outputColumn = column < 4 ? outputFromState[column] : outputFromInput[column - 4];
+        auto& stateColumn = column < 4 ? stateFromState[column] : stateFromInput[column - 4];
+
+        //lanes past the fourth never hold state, they stay 0.
+        for (size_t i = 0; i < stepLength; ++i)
+        {
+            outputColumn.set(i, static_cast<float>(outputs[i]));
+            stateColumn.set(i, i < 4 ? static_cast<float>(state[i]) : 0.f);
+        }
+    }
+}
+
+void KWeighting::process(State& state, const float* samples, int numSamples, Levels& levels) const noexcept
+{
+    auto s = state.values;
+    auto zero = Vec::expand(0.f);
+    auto peak = zero, energy = zero, weightedEnergy = zero;
+
+    alignas(Vec::SIMDRegisterSize) float step[stepLength];
+
+    const auto length = static_cast<int>(stepLength);
+    int i = 0;
+
+    for (; i + length <= numSamples; i += length)
+    {
+        std::copy(samples + i, samples + i + length, step);
+        auto input = Vec::fromRawArray(step);
+
+        peak = Vec::max(peak, Vec::max(input, zero - input));
+        energy += input * input;
+
+        //the input terms don't depend on the previous step, so only the state terms sit on the recursion. they're summed in pairs to keep that chain short.
+        auto s0 = Vec::expand(s.get(0)), s1 = Vec::expand(s.get(1)), s2 = Vec::expand(s.get(2)), s3 = Vec::expand(s.get(3));
+        auto outputFromInputs = zero, stateFromInputs = zero;
+
+        for (size_t j = 0; j < stepLength; j += 2)
+        {
+            auto x0 = Vec::expand(step[j]), x1 = Vec::expand(step[j + 1]);
+
+            outputFromInputs += outputFromInput[j] * x0 + outputFromInput[j + 1] * x1;
+            stateFromInputs += stateFromInput[j] * x0 + stateFromInput[j + 1] * x1;
+        }
+
+        auto output = (outputFromState[0] * s0 + outputFromState[1] * s1) + (outputFromState[2] * s2 + outputFromState[3] * s3) + outputFromInputs;
+        s = (stateFromState[0] * s0 + stateFromState[1] * s1) + (stateFromState[2] * s2 + stateFromState[3] * s3) + stateFromInputs;
+
+        weightedEnergy += output * output;
+    }
+
+    auto peakValue = 0.f;
+
+    for (size_t j = 0; j < stepLength; ++j)
+        peakValue = juce::jmax(peakValue, peak.get(j));
+
+    auto energyValue = energy.sum(), weightedEnergyValue = weightedEnergy.sum();
+
+    //the samples that don't fill a step go through the sections one at a time, on the same state.
+    if (i < numSamples)
+    {
+        float scalarState[4] { s.get(0), s.get(1), s.get(2), s.get(3) };
+
+        for (; i < numSamples; ++i)
+        {
+            auto input = samples[i];
+            auto output = stepSections(sections.data(), scalarState, input);
+
+            peakValue = juce::jmax(peakValue, std::abs(input));
+            energyValue += input * input;
+            weightedEnergyValue += output * output;
+        }
+
+        for (size_t j = 0; j < 4; ++j)
+            s.set(j, scalarState[j]);
+    }
+
+    state.values = s;
+
+    levels.peak = juce::jmax(levels.peak, peakValue);
+    levels.energy += energyValue;
+    levels.weightedEnergy += weightedEnergyValue;
+}
+
+//==============================================================================
+void OutputMeter::prepare(double sampleRate, const juce::AudioChannelSet& layout)
+{
+    kWeighting.prepare(sampleRate);
+    binLength = juce::jmax(1, juce::roundToInt(sampleRate * 0.1));
+
+    auto numChannels = layout.size();
+    channels.resize(static_cast<size_t>(numChannels));
+    loudnessWeights.resize(static_cast<size_t>(numChannels));
+
+    for (int i = 0; i < numChannels; ++i)
+        loudnessWeights[static_cast<size_t>(i)] = getLoudnessWeight(layout.getTypeOfChannel(i));
+
+    if (numChannels != numPublishedChannels)
+    {
+        const juce::ScopedLock lock(publishedLock);
+
+        peaks.reset(new std::atomic<float>[static_cast<size_t>(numChannels)]);
+        rmsLevels.reset(new std::atomic<float>[static_cast<size_t>(numChannels)]);
+        numPublishedChannels = numChannels;
+        numMeteredChannels.store(0, std::memory_order_relaxed);
+    }
+
+    reset();
+}
+
+void OutputMeter::reset() noexcept
+{
+    for (auto& channel : channels)
+        channel = Channel();
+
+    loudnessBins.fill(0.0);
+    samplesInBin = 0;
+    binIndex = 0;
+
+    for (size_t i = 0; i < static_cast<size_t>(numPublishedChannels); ++i)
+    {
+        peaks[i].store(0.f, std::memory_order_relaxed);
+        rmsLevels[i].store(0.f, std::memory_order_relaxed);
+    }
+
+    momentaryLoudness.store(silentLoudness, std::memory_order_relaxed);
+    shortTermLoudness.store(silentLoudness, std::memory_order_relaxed);
+}
+
+void OutputMeter::process(const juce::AudioBuffer<float>& buffer, int numChannels) noexcept
+{
+    //the windows are cleared when metering starts again, they'd still hold whatever played before it stopped.
+    if (! reading.load(std::memory_order_relaxed))
+    {
+        wasReading = false;
+        return;
+    }
+
+    if (! wasReading)
+    {
+        reset();
+        wasReading = true;
+    }
+
+    numChannels = juce::jmin(numChannels, buffer.getNumChannels(), static_cast<int>(channels.size()));
+    numMeteredChannels.store(numChannels, std::memory_order_relaxed);
+
+    //bins end at fixed sample positions, so a block is split wherever one completes.
+    for (int start = 0; start < buffer.getNumSamples();)
+    {
+        auto length = juce::jmin(buffer.getNumSamples() - start, binLength - samplesInBin);
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            auto& channel = channels[static_cast<size_t>(i)];
+
+            KWeighting::Levels levels;
+            kWeighting.process(channel.state, buffer.getReadPointer(i, start), length, levels);
+
+            channel.blockPeak = juce::jmax(channel.blockPeak, levels.peak);
+            channel.binEnergy += levels.energy;
+            channel.binWeightedEnergy += levels.weightedEnergy;
+        }
+
+        start += length;
+        samplesInBin += length;
+
+        if (samplesInBin == binLength)
+            completeBin(numChannels);
+    }
+
+    //the editor takes the peak when it reads, so raise it rather than overwrite it and no peak between two reads is lost.
+    for (int i = 0; i < numChannels; ++i)
+    {
+        auto& published = peaks[static_cast<size_t>(i)];
+        auto blockPeak = std::exchange(channels[static_cast<size_t>(i)].blockPeak, 0.f);
+        auto current = published.load(std::memory_order_relaxed);
+
+        while (blockPeak > current && ! published.compare_exchange_weak(current, blockPeak, std::memory_order_relaxed))
+        {
+        }
+    }
+}
+
+void OutputMeter::completeBin(int numChannels) noexcept
+{
+    auto weightedMeanSquare = 0.0;
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        auto& channel = channels[static_cast<size_t>(i)];
+
+        weightedMeanSquare += loudnessWeights[static_cast<size_t>(i)] * channel.binWeightedEnergy / binLength;
+        channel.energyBins[static_cast<size_t>(binIndex % rmsBins)] = channel.binEnergy / binLength;
+
+        auto meanSquare = std::accumulate(channel.energyBins.begin(), channel.energyBins.end(), 0.0) / rmsBins;
+        rmsLevels[static_cast<size_t>(i)].store(static_cast<float>(std::sqrt(meanSquare)), std::memory_order_relaxed);
+
+        channel.binEnergy = 0.0;
+        channel.binWeightedEnergy = 0.0;
+    }
+
+    loudnessBins[static_cast<size_t>(binIndex % shortTermBins)] = weightedMeanSquare;
+
+    //the windows reach back from the bin just completed. before they've filled up the missing bins count as silence.
+    auto momentary = 0.0;
+
+    for (int i = 0; i < momentaryBins; ++i)
+        momentary += loudnessBins[static_cast<size_t>((binIndex - i + shortTermBins) % shortTermBins)];
+
+    auto shortTerm = std::accumulate(loudnessBins.begin(), loudnessBins.end(), 0.0);
+
+    momentaryLoudness.store(toLoudness(momentary / momentaryBins), std::memory_order_relaxed);
+    shortTermLoudness.store(toLoudness(shortTerm / shortTermBins), std::memory_order_relaxed);
+
+    samplesInBin = 0;
+    binIndex = (binIndex + 1) % shortTermBins;
+}
+
+OutputMeter::Readings OutputMeter::read()
+{
+    const juce::ScopedLock lock(publishedLock);
+
+    Readings readings;
+    readings.numChannels = juce::jmin(numMeteredChannels.load(std::memory_order_relaxed), numPublishedChannels);
+    readings.peak.resize(static_cast<size_t>(readings.numChannels));
+    readings.rms.resize(static_cast<size_t>(readings.numChannels));
+
+    for (size_t i = 0; i < static_cast<size_t>(readings.numChannels); ++i)
+    {
+        readings.peak[i] = peaks[i].exchange(0.f, std::memory_order_relaxed);
+        readings.rms[i] = rmsLevels[i].load(std::memory_order_relaxed);
+    }
+
+    readings.momentaryLoudness = momentaryLoudness.load(std::memory_order_relaxed);
+    readings.shortTermLoudness = shortTermLoudness.load(std::memory_order_relaxed);
+
+    return readings;
+}
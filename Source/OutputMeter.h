@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    OutputMeter.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//the BS.1770 K-weighting: a high shelf followed by a high pass, designed as two biquads like every other stage.
+//the meter runs them as one 4th order state space system a register's worth of samples at a time, so a whole SIMD register of outputs comes out of each step instead of one sample per step through two dependent recursions.
+class KWeighting
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<float>;
+
+    //samples per step: 4 with sse or neon, 8 with avx. the state's four entries sit in the first four lanes.
+    static constexpr size_t stepLength = Vec::SIMDNumElements;
+    static_assert(stepLength >= 4, "the state needs four lanes");
+
+    //the two sections, normalised like the stages of a ChainResponse.
+    static std::array<Coefficients, 2> makeFilters(double sampleRate);
+
+    void prepare(double sampleRate);
+
+    //the state of both sections in transposed direct form II: shelf s1, s2, then high pass s1, s2.
+    struct State
+    {
+        Vec values { Vec::expand(0.f) };
+    };
+
+    //levels of a run of samples, summed over the run.
+    struct Levels
+    {
+        float peak { 0.f }, energy { 0.f }, weightedEnergy { 0.f };
+    };
+
+    //filters samples through the K-weighting and accumulates the unweighted peak and energy alongside, in one pass over the input.
+    void process(State& state, const float* samples, int numSamples, Levels& levels) const noexcept;
+
+private:
+    //a step's samples in, as many out. outputs = fromState * state + fromInput * inputs, state = stateFromState * state + stateFromInput * inputs, one column per state entry or input sample.
+    std::array<Vec, 4> outputFromState, stateFromState;
+    std::array<Vec, stepLength> outputFromInput, stateFromInput;
+
+    //the sections themselves, for the samples left over after the last full step.
+    std::array<std::array<float, 5>, 2> sections {};
+};
+
+//peak, rms and BS.1770 momentary / short-term loudness of the processor's output.
+//the audio thread accumulates levels into 100 ms bins and publishes through atomics, the editor polls them. nothing locks or allocates on the audio thread.
+//it only meters while something reads it, i.e. while the editor's meter is showing. headless and offline instances, and every instance whose editor is closed, don't pay for it. the benchmark harness reports what it costs next to the eq.
+class OutputMeter
+{
+public:
+    //sized for the layout's channels, which also gives their loudness weights. doesn't run alongside process().
+    void prepare(double sampleRate, const juce::AudioChannelSet& layout);
+
+    //audio thread.
+    void process(const juce::AudioBuffer<float>& buffer, int numChannels) noexcept;
+
+    //any thread. metering starts from empty windows each time it's switched on, so the loudness takes the window's length to settle.
+    void setReading(bool shouldRead) noexcept { reading.store(shouldRead, std::memory_order_relaxed); }
+
+    //levels are linear gain, loudness is LUFS. peaks are the highest since the previous read, rms covers the last 300 ms.
+    struct Readings
+    {
+        int numChannels { 0 };
+        std::vector<float> peak, rms;
+        float momentaryLoudness { silentLoudness }, shortTermLoudness { silentLoudness };
+    };
+
+    //message thread.
+    Readings read();
+
+    //reported for a window of digital silence.
+    static constexpr float silentLoudness = -100.f;
+
+private:
+    //bins per window: 400 ms momentary, 3 s short-term, 300 ms rms.
+    static constexpr int momentaryBins = 4, shortTermBins = 30, rmsBins = 3;
+
+    //audio thread state.
+    KWeighting kWeighting;
+    int binLength { 4410 }, samplesInBin { 0 }, binIndex { 0 };
+    bool wasReading { false };
+
+    struct Channel
+    {
+        KWeighting::State state;
+        float blockPeak { 0.f };
+        double binEnergy { 0.0 }, binWeightedEnergy { 0.0 };
+        std::array<double, rmsBins> energyBins {};
+    };
+
+    std::vector<Channel> channels;
+
+    //BS.1770 weight of each channel's loudness.
+    std::vector<double> loudnessWeights;
+    std::array<double, shortTermBins> loudnessBins {};
+
+    void reset() noexcept;
+    void completeBin(int numChannels) noexcept;
+
+    std::atomic<bool> reading { false };
+
+    //published to the editor.
+    std::atomic<int> numMeteredChannels { 0 };
+    std::unique_ptr<std::atomic<float>[]> peaks, rmsLevels;
+    int numPublishedChannels { 0 };
+
+    //held by prepare() while it replaces what's published and by read(), the audio thread never takes it.
+    juce::CriticalSection publishedLock;
+    std::atomic<float> momentaryLoudness { silentLoudness }, shortTermLoudness { silentLoudness };
+};
@@ -8,74 +8,151 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "MatchEQ.h"
+
+//the filters' settings, and mid/side which decides whether a side curve is published. the suppressor's parameters don't change the curve.
+static bool isResponseParameter(const juce::String& parameterID)
+{
+    for (auto* suffix : { " Freq", " Gain", " Q", " On", " Slope" })
+        if (parameterID.endsWith(suffix))
+            return true;
+    
+    return parameterID == "Filter Topology" || parameterID == "Coefficient Design" || parameterID == "Mid Side";
+}
 
 ResponseCurveComponent::ResponseCurveComponent(RuckusEQAudioProcessor& p) : audioProcessor(p)
 {
-    //listen for when parameters change, grab parameters from audio processor and add ourselves as a listener to them.
-    const auto& params = audioProcessor.getParameters();
-    for(auto param : params)
+    //listen for when the response parameters change, grab parameters from audio processor and add ourselves as a listener to them.
+    for (auto* param : audioProcessor.getParameters())
     {
-        param->addListener(this);
+        if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(param))
+        {
+            if (isResponseParameter(withID->getParameterID()))
+            {
+                param->addListener(this);
+                responseParameters.add(param);
+            }
+        }
     }
-    
-    //start timer to check every 60Hz to see if we need to repaint the response curve
-    startTimerHz(60);
 }
 
 ResponseCurveComponent::~ResponseCurveComponent()
 {
     //deregister as a listener when the destructor is called
-    const auto& params = audioProcessor.getParameters();
-    for(auto param : params)
-    {
+    for (auto* param : responseParameters)
         param->removeListener(this);
-    }
+    
+    cancelPendingUpdate();
 }
 
 void ResponseCurveComponent::parameterValueChanged(int parameterIndex, float newValue)
 {
-    //set atomic flag to true if a plugin parameter is changed
-    parametersChanged.set(true);
+    //the vblank is attached on the message thread, the first frame after that picks the change up.
+    parametersChanged.store(true);
+    triggerAsyncUpdate();
+}
+
+void ResponseCurveComponent::handleAsyncUpdate()
+{
+    updateVBlankAttachment();
 }
 
-//check if the parameters have been changed in the timer callback
-void ResponseCurveComponent::timerCallback()
+bool ResponseCurveComponent::isExpectingChange() const noexcept
 {
-    //only refresh the curve if a change has been made- if a change has been made set the parametersChanged back to false so the curve isn't being continuously refreshed.
-    if (parametersChanged.compareAndSetBool(false, true))
+    return framesUntilIdle > 0 || parametersChanged.load();
+}
+
+void ResponseCurveComponent::updateVBlankAttachment()
+{
+    if (isShowing() && isExpectingChange())
     {
-        //update monochain
-        auto chainSettings = getChainSettings(audioProcessor.apvts);
-        
-        auto rumbleCoefficients = makeRumbleFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCoefficients(monoChain.get<ChainPositions::rumble>().coefficients, rumbleCoefficients);
-        
-        auto lowCoefficients = makeLowFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCoefficients(monoChain.get<ChainPositions::low>().coefficients, lowCoefficients);
-        
-        auto lowMidCoefficients = makeLowMidFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCoefficients(monoChain.get<ChainPositions::lowMid>().coefficients, lowMidCoefficients);
-        
-        auto highMidCoefficients = makeHighMidFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCoefficients(monoChain.get<ChainPositions::highMid>().coefficients, highMidCoefficients);
-        
-        auto highCoefficients = makeHighFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCoefficients(monoChain.get<ChainPositions::high>().coefficients, highCoefficients);
-        
-        auto airCoefficients = makeAirFilter(chainSettings, audioProcessor.getSampleRate());
-        updateCoefficients(monoChain.get<ChainPositions::air>().coefficients, airCoefficients);
-        
-        auto highPassCoefficients = makeHighPassFilter(chainSettings, audioProcessor.getSampleRate());
-        updatePassFilter(monoChain.get<ChainPositions::highPass>(), highPassCoefficients, chainSettings.highPassSlope);
-        
-        auto lowPassCoefficients = makeLowPassFilter(chainSettings, audioProcessor.getSampleRate());
-        updatePassFilter(monoChain.get<ChainPositions::lowPass>(), lowPassCoefficients, chainSettings.lowPassSlope);
-        
-        //signal a repaint so a new response curve is drawn
+        if (vBlankAttachment == nullptr)
+            vBlankAttachment = std::make_unique<juce::VBlankAttachment>(this, [this] { onVBlank(); });
+    }
+    else
+    {
+        vBlankAttachment.reset();
+    }
+}
+
+//the processor may have published while the curve was hidden, so it looks once more when it's shown.
+void ResponseCurveComponent::visibilityChanged()
+{
+    framesUntilIdle = framesToWaitForProcessor;
+    updateVBlankAttachment();
+}
+
+void ResponseCurveComponent::parentHierarchyChanged()
+{
+    framesUntilIdle = framesToWaitForProcessor;
+    updateVBlankAttachment();
+}
+
+//called once per display refresh while a change is on its way. the processor publishes from the audio thread, so rather than being told, the curve compares the published version here. any number of published changes cost a single copy and repaint per frame.
+void ResponseCurveComponent::onVBlank()
+{
+    //a parameter change shows up in the published coefficients on the processor's next block. give it a few frames before assuming the host isn't processing.
+    if (parametersChanged.exchange(false))
+    {
+        isWaitingForProcessor = true;
+        framesUntilIdle = framesToWaitForProcessor;
+    }
+    
+    auto& published = getShownResponse();
+    
+    if (published.getVersion() != lastVersion)
+    {
+        lastVersion = published.read(response);
+        isWaitingForProcessor = false;
+        framesUntilIdle = framesToWaitForProcessor;
         repaint();
+        return;
+    }
+    
+    if (framesUntilIdle > 0 && --framesUntilIdle == 0)
+    {
+        if (isWaitingForProcessor)
+        {
+            designWithoutProcessor();
+            repaint();
+            isWaitingForProcessor = false;
+        }
+        
+        //nothing more is coming. the attachment is dropped on the message loop's next pass rather than from inside its own callback.
+        triggerAsyncUpdate();
     }
 }
 
+//hosts that suspend processing while the transport is stopped never publish, so the curve designs the settings itself rather than freeze. same design as the processor's biquad path, at the rate it last ran.
+void ResponseCurveComponent::designWithoutProcessor()
+{
+    auto sampleRate = response.sampleRate > 0.0 ? response.sampleRate : audioProcessor.getSampleRate();
+    
+    if (sampleRate <= 0.0)
+        return;
+    
+    updateMonoChain(fallbackChain, getChainSettings(audioProcessor.apvts, showsSide ? sideParameterPrefix : ""), sampleRate);
+    captureResponse(fallbackChain, sampleRate, response);
+}
+
+PublishedChainResponse& ResponseCurveComponent::getShownResponse() noexcept
+{
+    return showsSide ? audioProcessor.getPublishedSideResponse() : audioProcessor.getPublishedResponse();
+}
+
+//the other set's version numbers mean nothing here, so the next frame takes whatever that set last published. if it has never been published, e.g. mid/side isn't running, the curve falls back to designing the settings itself.
+void ResponseCurveComponent::setShowsSide(bool shouldShowSide)
+{
+    if (showsSide == shouldShowSide)
+        return;
+    
+    showsSide = shouldShowSide;
+    lastVersion = 0;
+    
+    parametersChanged.store(true);
+    updateVBlankAttachment();
+}
+
 void ResponseCurveComponent::paint (juce::Graphics& g)
 {
     using namespace juce;
@@ -85,73 +162,21 @@ void ResponseCurveComponent::paint (juce::Graphics& g)
     
     auto w = responseArea.getWidth();
     
-    //get the parameters of each of the filters
-    auto& highPass = monoChain.get<ChainPositions::highPass>();
-    auto& rumble = monoChain.get<ChainPositions::rumble>();
-    auto& low = monoChain.get<ChainPositions::low>();
-    auto& lowMid = monoChain.get<ChainPositions::lowMid>();
-    auto& highMid = monoChain.get<ChainPositions::highMid>();
-    auto& high = monoChain.get<ChainPositions::high>();
-    auto& air = monoChain.get<ChainPositions::air>();
-    auto& lowPass = monoChain.get<ChainPositions::lowPass>();
+    if (w <= 0)
+        return;
     
-    auto sampleRate = audioProcessor.getSampleRate();
+    //the curve is drawn at the sample rate the coefficients were designed for, not whatever the host reports right now.
+    auto sampleRate = response.sampleRate;
     
-    //create a vector to store the magnitudes of each filter
-    std::vector<double> mags;
+    g.setColour(Colours::orange);
+    g.drawRoundedRectangle(responseArea.toFloat(), 4.f, 1.f);
     
-    //compute one magnitude per pixel, length of entire magnitude vector is equal to pixel length of the width of the response area.
-    mags.resize(w);
+    //nothing has been designed yet, the processor hasn't been prepared.
+    if (sampleRate <= 0.0)
+        return;
     
-    //iterate through each pixel and compute the magnitude at that frequency
-    for (int i = 0; i < w; i++)
-    {
-        //starting gain of 1
-        double mag = 1.f;
-        
-        //helper function to map magnitudes from pixel space to frequency space
-        auto freq = mapToLog10(double(i) / double (w), 20.0, 22000.0);
-        
-        //call magnitude function with freq and multiply the results by mag, make sure band isn't bypassed.
-        if(!monoChain.isBypassed<ChainPositions::rumble>())
-            mag *= rumble.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if(!monoChain.isBypassed<ChainPositions::low>())
-            mag *= low.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if(!monoChain.isBypassed<ChainPositions::lowMid>())
-            mag *= lowMid.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if(!monoChain.isBypassed<ChainPositions::highMid>())
-            mag *= highMid.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if(!monoChain.isBypassed<ChainPositions::high>())
-            mag *= high.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if(!monoChain.isBypassed<ChainPositions::air>())
-            mag *= air.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if(!highPass.isBypassed<0>())
-            mag *= highPass.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!highPass.isBypassed<1>())
-            mag *= highPass.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!highPass.isBypassed<2>())
-            mag *= highPass.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!highPass.isBypassed<3>())
-            mag *= highPass.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        if(!lowPass.isBypassed<0>())
-            mag *= lowPass.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!lowPass.isBypassed<1>())
-            mag *= lowPass.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!lowPass.isBypassed<2>())
-            mag *= lowPass.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        if(!lowPass.isBypassed<3>())
-            mag *= lowPass.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-        
-        //convert gain to decibels
-        mags[i] = Decibels::gainToDecibels(mag);
-    }
+    //compute one magnitude per pixel. the pixel frequencies only change with the width or the sample rate, so their trig terms are computed once and each stage then costs a few multiply-adds per pixel instead of a complex evaluation.
+    computeResponseCurve(response, static_cast<size_t>(w), magnitudeGrid, power, mags);
     
     //create a path in order to convert vector of magnitudes into a path
     Path responseCurve;
@@ -170,52 +195,242 @@ void ResponseCurveComponent::paint (juce::Graphics& g)
         responseCurve.lineTo(responseArea.getX() + i, map(mags[i]));
     }
     
+    g.setColour(Colours::white);
+    g.strokePath(responseCurve, PathStrokeType(2.f));
+}
+
+//==============================================================================
+LevelMeterComponent::LevelMeterComponent(OutputMeter& m) : meter(m)
+{
+    
+}
+
+LevelMeterComponent::~LevelMeterComponent()
+{
+    meter.setReading(false);
+}
+
+void LevelMeterComponent::visibilityChanged()
+{
+    updatePolling();
+}
+
+void LevelMeterComponent::parentHierarchyChanged()
+{
+    updatePolling();
+}
+
+//the processor only meters while the meter is showing, so a hidden or closed editor costs the audio thread nothing.
+void LevelMeterComponent::updatePolling()
+{
+    meter.setReading(isShowing());
+    
+    if (isShowing())
+    {
+        startTimerHz(30);
+    }
+    else
+    {
+        stopTimer();
+        std::fill(heldPeaks.begin(), heldPeaks.end(), 0.f);
+    }
+}
+
+void LevelMeterComponent::timerCallback()
+{
+    readings = meter.read();
+    heldPeaks.resize(static_cast<size_t>(readings.numChannels), 0.f);
+    
+    //20 dB per second at 30 Hz.
+    const auto fallPerFrame = juce::Decibels::decibelsToGain(-20.f / 30.f);
+    
+    for (size_t i = 0; i < heldPeaks.size(); ++i)
+        heldPeaks[i] = juce::jmax(readings.peak[i], heldPeaks[i] * fallPerFrame);
+    
+    repaint();
+}
+
+void LevelMeterComponent::paint(juce::Graphics& g)
+{
+    using namespace juce;
+    
+    auto bounds = getLocalBounds().reduced(2);
+    
     g.setColour(Colours::orange);
-    g.drawRoundedRectangle(responseArea.toFloat(), 4.f, 1.f);
+    g.drawRoundedRectangle(getLocalBounds().toFloat(), 4.f, 1.f);
+    
+    //two lines of loudness text at the bottom, the bars above.
+    auto textArea = bounds.removeFromBottom(28);
+    
+    auto loudnessText = [](const char* label, float loudness)
+    {
+        return String(label) + (loudness <= OutputMeter::silentLoudness ? String("-inf") : String(loudness, 1));
+    };
     
     g.setColour(Colours::white);
-    g.strokePath(responseCurve, PathStrokeType(2.f));
+    g.setFont(11.f);
+    g.drawText(loudnessText("M ", readings.momentaryLoudness), textArea.removeFromTop(14), Justification::centred);
+    g.drawText(loudnessText("S ", readings.shortTermLoudness), textArea, Justification::centred);
+    
+    if (readings.numChannels <= 0)
+        return;
+    
+    const auto barWidth = bounds.getWidth() / readings.numChannels;
+    const float bottom = bounds.getBottom(), top = bounds.getY();
+    
+    auto map = [bottom, top](float gain)
+    {
+        return jmap(jlimit(-60.f, 6.f, Decibels::gainToDecibels(gain, -60.f)), -60.f, 6.f, bottom, top);
+    };
+    
+    for (int channel = 0; channel < readings.numChannels; ++channel)
+    {
+        auto bar = bounds.removeFromLeft(barWidth).reduced(1, 0).toFloat();
+        
+        g.setColour(Colours::darkgrey);
+        g.fillRect(bar);
+        
+        g.setColour(Colours::orange);
+        g.fillRect(bar.withTop(map(readings.rms[static_cast<size_t>(channel)])));
+        
+        //clipped peaks turn red.
+        auto peak = heldPeaks[static_cast<size_t>(channel)];
+        g.setColour(peak >= 1.f ? Colours::red : Colours::white);
+        g.fillRect(bar.withTop(map(peak)).withHeight(2.f));
+    }
 }
 
 //==============================================================================
 RuckusEQAudioProcessorEditor::RuckusEQAudioProcessorEditor (RuckusEQAudioProcessor& p)
     : AudioProcessorEditor (&p), audioProcessor (p),
 responseCurveComponent(audioProcessor),
-highPassFreqSliderAttachment(audioProcessor.apvts, "HighPass Freq", highPassFreqSlider),
-rumbleFreqSliderAttachment(audioProcessor.apvts, "Rumble Freq", rumbleFreqSlider),
-rumbleGainSliderAttachment(audioProcessor.apvts, "Rumble Gain", rumbleGainSlider),
-lowFreqSliderAttachment(audioProcessor.apvts, "Low Freq", lowFreqSlider),
-lowGainSliderAttachment(audioProcessor.apvts, "Low Gain", lowGainSlider),
-lowMidFreqSliderAttachment(audioProcessor.apvts, "LowMid Freq", lowMidFreqSlider),
-lowMidGainSliderAttachment(audioProcessor.apvts, "LowMid Gain", lowMidGainSlider),
-highMidFreqSliderAttachment(audioProcessor.apvts, "HighMid Freq", highMidFreqSlider),
-highMidGainSliderAttachment(audioProcessor.apvts, "HighMid Gain", highMidGainSlider),
-highFreqSliderAttachment(audioProcessor.apvts, "High Freq", highFreqSlider),
-highGainSliderAttachment(audioProcessor.apvts, "High Gain", highGainSlider),
-airFreqSliderAttachment(audioProcessor.apvts, "Air Freq", airFreqSlider),
-airGainSliderAttachment(audioProcessor.apvts, "Air Gain", airGainSlider),
-lowPassFreqSliderAttachment(audioProcessor.apvts, "LowPass Freq", lowPassFreqSlider),
-rumbleQualitySliderAttachment(audioProcessor.apvts, "Rumble Q", rumbleQualitySlider),
-lowQualitySliderAttachment(audioProcessor.apvts, "Low Q", lowQualitySlider),
-lowMidQualitySliderAttachment(audioProcessor.apvts, "LowMid Q", lowMidQualitySlider),
-highMidQualitySliderAttachment(audioProcessor.apvts, "HighMid Q", highMidQualitySlider),
-highQualitySliderAttachment(audioProcessor.apvts, "High Q", highQualitySlider),
-airQualitySliderAttachment(audioProcessor.apvts, "Air Q", airQualitySlider),
-highPassSlopeSliderAttachment(audioProcessor.apvts, "HighPass Slope", highPassSlopeSlider),
-lowPassSlopeSliderAttachment(audioProcessor.apvts, "LowPass Slope", lowPassSlopeSlider)
+levelMeter(audioProcessor.getOutputMeter()),
+presetBrowser(audioProcessor),
+resonanceDepthSliderAttachment(audioProcessor.apvts, "Resonance Depth", resonanceDepthSlider),
+resonanceThresholdSliderAttachment(audioProcessor.apvts, "Resonance Threshold", resonanceThresholdSlider),
+resonanceButtonAttachment(audioProcessor.apvts, "Resonance Suppression", resonanceButton),
+midSideButtonAttachment(audioProcessor.apvts, "Mid Side", midSideButton)
 {
+    for (const auto& band : peakBands)
+        peakBandControls.add(new PeakBandControls(band));
+    
+    attachEqControls(false);
+    
     //batch add all of the sliders to the gui
     for(auto* comp: getComps())
     {
         addAndMakeVisible(comp);
     }
     
-    setSize (800, 533);
+    //hidden until asked for, and added last so it sits on top of the curve.
+    addChildComponent(presetBrowser);
+    
+    presetsButton.setClickingTogglesState(true);
+    presetsButton.onClick = [this] { presetBrowser.setVisible(presetsButton.getToggleState()); };
+    
+    //match eq: pick a reference track, let the input play while learning, then fit the bands to the difference.
+    auto& matchEQ = audioProcessor.getMatchEQ();
+    
+    loadReferenceButton.onClick = [this]
+    {
+        referenceChooser = std::make_unique<juce::FileChooser>("Choose a reference track", juce::File(), "*.wav;*.aif;*.aiff;*.flac;*.ogg");
+        referenceChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles, [this](const juce::FileChooser& chooser)
+        {
+            auto file = chooser.getResult();
+            
+            if (file.existsAsFile())
+                audioProcessor.getMatchEQ().loadReference(file);
+        });
+    };
+    
+    learnInputButton.setToggleState(matchEQ.isLearning(), juce::dontSendNotification);
+    learnInputButton.onClick = [this] { audioProcessor.getMatchEQ().setLearning(learnInputButton.getToggleState()); };
+    
+    matchButton.onClick = [this] { audioProcessor.getMatchEQ().requestMatch(); };
+    
+    editSideButton.setClickingTogglesState(true);
+    editSideButton.onClick = [this] { attachEqControls(editSideButton.getToggleState()); };
+    
+    midSideButton.onStateChange = [this] { updateMidSideButtons(); };
+    
+    updateMidSideButtons();
+    audioProcessor.getLayoutChanges().addChangeListener(this);
+    
+    //the bars print their value, the suffix says which is which.
+    resonanceDepthSlider.setTextValueSuffix(" dB depth");
+    resonanceThresholdSlider.setTextValueSuffix(" dB threshold");
+    
+    //the strip of buttons along the top needs 980 px, extra bands widen the window further instead of squeezing the knobs.
+    setSize (juce::jmax(980, 100 * (static_cast<int>(numPeakBands) + 2)), 533);
+}
+
+RuckusEQAudioProcessorEditor::PeakBandControls::PeakBandControls(const PeakBandDescriptor& b)
+    : band(b), onButton(b.name)
+{
+    
+}
+
+void RuckusEQAudioProcessorEditor::PeakBandControls::attach(APVTS& apvts, const juce::String& prefix)
+{
+    //the old attachments go first, so they can't write the new parameter's value back to the one they were attached to.
+    freqSliderAttachment.reset();
+    gainSliderAttachment.reset();
+    qualitySliderAttachment.reset();
+    onButtonAttachment.reset();
+    
+    auto name = prefix + band.name;
+    
+    freqSliderAttachment = std::make_unique<Attachment>(apvts, name + " Freq", freqSlider);
+    gainSliderAttachment = std::make_unique<Attachment>(apvts, name + " Gain", gainSlider);
+    qualitySliderAttachment = std::make_unique<Attachment>(apvts, name + " Q", qualitySlider);
+    onButtonAttachment = std::make_unique<APVTS::ButtonAttachment>(apvts, name + " On", onButton);
+}
+
+void RuckusEQAudioProcessorEditor::attachEqControls(bool toSide)
+{
+    auto& apvts = audioProcessor.apvts;
+    juce::String prefix(toSide ? sideParameterPrefix : "");
+    
+    highPassFreqSliderAttachment.reset();
+    lowPassFreqSliderAttachment.reset();
+    highPassSlopeSliderAttachment.reset();
+    lowPassSlopeSliderAttachment.reset();
+    
+    highPassFreqSliderAttachment = std::make_unique<Attachment>(apvts, prefix + "HighPass Freq", highPassFreqSlider);
+    lowPassFreqSliderAttachment = std::make_unique<Attachment>(apvts, prefix + "LowPass Freq", lowPassFreqSlider);
+    highPassSlopeSliderAttachment = std::make_unique<Attachment>(apvts, prefix + "HighPass Slope", highPassSlopeSlider);
+    lowPassSlopeSliderAttachment = std::make_unique<Attachment>(apvts, prefix + "LowPass Slope", lowPassSlopeSlider);
+    
+    for (auto* controls : peakBandControls)
+        controls->attach(apvts, prefix);
+    
+    responseCurveComponent.setShowsSide(toSide);
 }
 
 RuckusEQAudioProcessorEditor::~RuckusEQAudioProcessorEditor()
 {
+    audioProcessor.getLayoutChanges().removeChangeListener(this);
+}
+
+//edit side only means something while mid/side is running. turning it off goes back to the main set, which is then the whole eq.
+void RuckusEQAudioProcessorEditor::updateMidSideButtons()
+{
+    auto canProcessMidSide = audioProcessor.canProcessMidSide();
+    auto isMidSide = canProcessMidSide && midSideButton.getToggleState();
     
+    midSideButton.setEnabled(canProcessMidSide);
+    editSideButton.setEnabled(isMidSide);
+    
+    if (! isMidSide && editSideButton.getToggleState())
+    {
+        editSideButton.setToggleState(false, juce::dontSendNotification);
+        attachEqControls(false);
+    }
+}
+
+void RuckusEQAudioProcessorEditor::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    updateMidSideButtons();
 }
 
 //==============================================================================
@@ -233,46 +448,47 @@ void RuckusEQAudioProcessorEditor::resized()
     //boundary of the entire plugin window
     auto bounds = getLocalBounds();
     
+    //thin strip along the top for the match eq controls
+    auto matchArea = bounds.removeFromTop(24);
+    loadReferenceButton.setBounds(matchArea.removeFromLeft(120).reduced(2));
+    learnInputButton.setBounds(matchArea.removeFromLeft(100).reduced(2));
+    matchButton.setBounds(matchArea.removeFromLeft(80).reduced(2));
+    
+    //resonance suppression shares the strip
+    resonanceButton.setBounds(matchArea.removeFromLeft(160).reduced(2));
+    resonanceDepthSlider.setBounds(matchArea.removeFromLeft(120).reduced(2));
+    resonanceThresholdSlider.setBounds(matchArea.removeFromLeft(140).reduced(2));
+    
+    //then mid/side
+    midSideButton.setBounds(matchArea.removeFromLeft(90).reduced(2));
+    editSideButton.setBounds(matchArea.removeFromLeft(80).reduced(2));
+    
+    presetsButton.setBounds(matchArea.removeFromLeft(80).reduced(2));
+    
     //allocate top 40% of the plugin window for the frequency response curve
     auto responseArea = bounds.removeFromTop(bounds.getHeight() * 0.6);
+    levelMeter.setBounds(responseArea.removeFromRight(70));
     responseCurveComponent.setBounds(responseArea);
+    presetBrowser.setBounds(responseArea);
+    
+    //the bottom is split into equal columns: HPF, one per peak band, LPF
+    auto columnWidth = bounds.getWidth() / (static_cast<int>(numPeakBands) + 2);
     
-    //allocate left 12.5% of bottom of window for HPF
-    auto highPassArea = bounds.removeFromLeft(bounds.getWidth() * 0.125);
+    auto highPassArea = bounds.removeFromLeft(columnWidth);
     highPassFreqSlider.setBounds(highPassArea.removeFromTop(highPassArea.getHeight() * 0.7));
     highPassSlopeSlider.setBounds(highPassArea);
     
-    auto rumbleArea = bounds.removeFromLeft(bounds.getWidth() * (12.5/87.5));
-    rumbleFreqSlider.setBounds(rumbleArea.removeFromTop(rumbleArea.getHeight() * 0.4));
-    rumbleGainSlider.setBounds(rumbleArea.removeFromTop(rumbleArea.getHeight() * 0.667));
-    rumbleQualitySlider.setBounds(rumbleArea);
-    
-    auto lowArea = bounds.removeFromLeft(bounds.getWidth() * (12.5/75));
-    lowFreqSlider.setBounds(lowArea.removeFromTop(lowArea.getHeight() * 0.4));
-    lowGainSlider.setBounds(lowArea.removeFromTop(lowArea.getHeight() * 0.667));
-    lowQualitySlider.setBounds(lowArea);
-
-    auto lowMidArea = bounds.removeFromLeft(bounds.getWidth() * (12.5/62.5));
-    lowMidFreqSlider.setBounds(lowMidArea.removeFromTop(lowMidArea.getHeight() * 0.4));
-    lowMidGainSlider.setBounds(lowMidArea.removeFromTop(lowMidArea.getHeight() * 0.667));
-    lowMidQualitySlider.setBounds(lowMidArea);
-
-    auto highMidArea = bounds.removeFromLeft(bounds.getWidth() * (12.5/50));
-    highMidFreqSlider.setBounds(highMidArea.removeFromTop(highMidArea.getHeight() * 0.4));
-    highMidGainSlider.setBounds(highMidArea.removeFromTop(highMidArea.getHeight() * 0.667));
-    highMidQualitySlider.setBounds(highMidArea);
-
-    auto highArea = bounds.removeFromLeft(bounds.getWidth() * (12.5/37.5));
-    highFreqSlider.setBounds(highArea.removeFromTop(highArea.getHeight() * 0.4));
-    highGainSlider.setBounds(highArea.removeFromTop(highArea.getHeight() * 0.667));
-    highQualitySlider.setBounds(highArea);
-
-    auto airArea = bounds.removeFromLeft(bounds.getWidth() * (12.5/25));
-    airFreqSlider.setBounds(airArea.removeFromTop(airArea.getHeight() * 0.4));
-    airGainSlider.setBounds(airArea.removeFromTop(airArea.getHeight() * 0.667));
-    airQualitySlider.setBounds(airArea);
-    
-    auto lowPassArea = bounds.removeFromRight(bounds.getWidth() * 1);
+    for (auto* controls : peakBandControls)
+    {
+        auto bandArea = bounds.removeFromLeft(columnWidth);
+        controls->onButton.setBounds(bandArea.removeFromTop(20));
+        controls->freqSlider.setBounds(bandArea.removeFromTop(bandArea.getHeight() * 0.4));
+        controls->gainSlider.setBounds(bandArea.removeFromTop(bandArea.getHeight() * 0.667));
+        controls->qualitySlider.setBounds(bandArea);
+    }
+    
+    //whatever is left after rounding goes to the LPF
+    auto lowPassArea = bounds;
     lowPassFreqSlider.setBounds(lowPassArea.removeFromTop(lowPassArea.getHeight() * 0.7));
     lowPassSlopeSlider.setBounds(lowPassArea);
 
@@ -280,16 +496,19 @@ void RuckusEQAudioProcessorEditor::resized()
 
 std::vector<juce::Component*> RuckusEQAudioProcessorEditor::getComps()
 {
-    return
+    std::vector<juce::Component*> comps { &highPassFreqSlider };
+    
+    for (auto* controls : peakBandControls)
+        comps.insert(comps.end(), { &controls->freqSlider, &controls->gainSlider, &controls->qualitySlider, &controls->onButton });
+    
+    comps.insert(comps.end(),
     {
-        &highPassFreqSlider,
-        &rumbleFreqSlider, &rumbleGainSlider, &rumbleQualitySlider,
-        &lowFreqSlider, &lowGainSlider, &lowQualitySlider,
-        &lowMidFreqSlider, &lowMidGainSlider, &lowMidQualitySlider,
-        &highMidFreqSlider, &highMidGainSlider, &highMidQualitySlider,
-        &highFreqSlider, &highGainSlider, &highQualitySlider,
-        &airFreqSlider, &airGainSlider, &airQualitySlider,
         &lowPassFreqSlider, &highPassSlopeSlider, &lowPassSlopeSlider,
-        &responseCurveComponent
-    };
+        &responseCurveComponent, &levelMeter,
+        &loadReferenceButton, &learnInputButton, &matchButton,
+        &resonanceButton, &resonanceDepthSlider, &resonanceThresholdSlider,
+        &midSideButton, &editSideButton, &presetsButton
+    });
+    
+    return comps;
 }
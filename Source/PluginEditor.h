@@ -10,6 +10,9 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "MagnitudeBatch.h"
+#include "OutputMeter.h"
+#include "PresetBrowser.h"
 
 struct CustomRotarySlider : juce::Slider
 {
@@ -37,29 +40,84 @@ struct CustomHorizontalBar : juce::Slider
 
 struct ResponseCurveComponent: juce::Component,
 juce::AudioProcessorParameter::Listener,
-juce::Timer
+juce::AsyncUpdater
 {
     ResponseCurveComponent(RuckusEQAudioProcessor&);
     ~ResponseCurveComponent();
     
-    //editor callbacks happen on the audio thread, so we can't do any gui stuff (repainting, etc.) in the callback. instead we can set an atomic flag that the timer can check and update based on the flag.
+    //editor callbacks happen on the audio thread, so we can't do any gui stuff (repainting, etc.) in the callback. instead we flag the change and have the message thread start watching the vblank for what the processor publishes.
     void parameterValueChanged (int parameterIndex, float newValue) override;
     void parameterGestureChanged (int parameterIndex, bool gestureIsStarting) override {}
-    void timerCallback() override; //query an atomic flag to decide if the chain needs updating and the component needs repainting.
+    void handleAsyncUpdate() override;
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
     void paint(juce::Graphics& g) override;
+    
+    //draws the side chain instead of the main one, while the editor is editing the side of a mid/side eq.
+    void setShowsSide(bool shouldShowSide);
 private:
     RuckusEQAudioProcessor& audioProcessor;
-    juce::Atomic<bool> parametersChanged {false};
     
-    //add an instance of the monochain from plugin processor so we can use it's data to draw the response curve.
-    MonoChain monoChain;
+    bool showsSide { false };
+    PublishedChainResponse& getShownResponse() noexcept;
+    
+    //only the parameters that shape the drawn response are listened to.
+    juce::Array<juce::AudioProcessorParameter*> responseParameters;
+    
+    //starts set, so an editor opened on a processor that isn't running still gets a curve.
+    std::atomic<bool> parametersChanged { true };
+    
+    //the coefficients being drawn, copied out of the processor's published set. nothing is designed here while the processor runs.
+    ChainResponse response;
+    juce::uint32 lastVersion { 0 };
+    
+    //about 100 ms at 60 Hz. after a change that long without a new set from the processor, the curve designs the settings itself. after a new set that long without another, it stops watching.
+    static constexpr int framesToWaitForProcessor = 6;
+    int framesUntilIdle { 0 };
+    bool isWaitingForProcessor { false };
+    MonoChain fallbackChain;
+    
+    //only exists while the component is showing and a change is on its way, so an idle or hidden curve costs nothing per frame.
+    std::unique_ptr<juce::VBlankAttachment> vBlankAttachment;
+    
+    bool isExpectingChange() const noexcept;
+    void updateVBlankAttachment();
+    void onVBlank();
+    void designWithoutProcessor();
+    
+    //per pixel trig terms, rebuilt only when the width or the sample rate changes.
+    MagnitudeGrid magnitudeGrid;
+    std::vector<double> power;
+    std::vector<float> mags;
+};
+
+//peak and rms bars per output channel with momentary and short-term loudness below, polled from the processor's meter at 30 Hz while showing.
+struct LevelMeterComponent : juce::Component,
+juce::Timer
+{
+    LevelMeterComponent(OutputMeter&);
+    ~LevelMeterComponent() override;
+    
+    void visibilityChanged() override;
+    void parentHierarchyChanged() override;
+    void timerCallback() override;
+    void paint(juce::Graphics& g) override;
+private:
+    OutputMeter& meter;
+    OutputMeter::Readings readings;
+    
+    //the drawn peaks hold the highest reading and fall back at about 20 dB per second.
+    std::vector<float> heldPeaks;
+    
+    void updatePolling();
 };
 
 //==============================================================================
 /**
 */
 // for the editor to respond to parameter changes, register it as a listener to all of them. therefore the editor will inherit from the class "Listener".
-class RuckusEQAudioProcessorEditor  : public juce::AudioProcessorEditor
+class RuckusEQAudioProcessorEditor  : public juce::AudioProcessorEditor,
+                                      private juce::ChangeListener
 {
 public:
     RuckusEQAudioProcessorEditor (RuckusEQAudioProcessor&);
@@ -73,41 +131,72 @@ private:
     RuckusEQAudioProcessor& audioProcessor;
     
     CustomRotarySlider  highPassFreqSlider,
-                        rumbleFreqSlider, rumbleGainSlider,
-                        lowFreqSlider, lowGainSlider,
-                        lowMidFreqSlider, lowMidGainSlider,
-                        highMidFreqSlider, highMidGainSlider,
-                        highFreqSlider, highGainSlider,
-                        airFreqSlider, airGainSlider,
                         lowPassFreqSlider;
     
-    CustomHorizontalBar  rumbleQualitySlider,
-                        lowQualitySlider,
-                        lowMidQualitySlider,
-                        highMidQualitySlider,
-                        highQualitySlider,
-                        airQualitySlider;
-    
     CustomHorizontalSlider highPassSlopeSlider, lowPassSlopeSlider;
     
     ResponseCurveComponent responseCurveComponent;
+    LevelMeterComponent levelMeter;
+    
+    //match eq controls
+    juce::TextButton loadReferenceButton { "Load Reference" }, matchButton { "Match" };
+    juce::ToggleButton learnInputButton { "Learn Input" };
+    std::unique_ptr<juce::FileChooser> referenceChooser;
+    
+    //mid/side controls. edit side points the cut and band controls at the side parameters.
+    juce::ToggleButton midSideButton { "Mid/Side" };
+    juce::TextButton editSideButton { "Edit Side" };
+    
+    //the preset browser opens over the response curve.
+    juce::TextButton presetsButton { "Presets" };
+    PresetBrowserComponent presetBrowser;
+    
+    //resonance suppression controls
+    juce::ToggleButton resonanceButton { "Suppress Resonances" };
+    CustomHorizontalBar resonanceDepthSlider, resonanceThresholdSlider;
     
     //connect sliders to dsp parameters
     using APVTS = juce::AudioProcessorValueTreeState;
     using Attachment = APVTS::SliderAttachment;
     
-    Attachment  highPassFreqSliderAttachment,
-                rumbleFreqSliderAttachment, rumbleGainSliderAttachment,
-                lowFreqSliderAttachment, lowGainSliderAttachment,
-                lowMidFreqSliderAttachment, lowMidGainSliderAttachment,
-                highMidFreqSliderAttachment, highMidGainSliderAttachment,
-                highFreqSliderAttachment, highGainSliderAttachment,
-                airFreqSliderAttachment, airGainSliderAttachment,
-                lowPassFreqSliderAttachment, rumbleQualitySliderAttachment,
-                lowQualitySliderAttachment, lowMidQualitySliderAttachment,
-                highMidQualitySliderAttachment, highQualitySliderAttachment,
-                airQualitySliderAttachment, highPassSlopeSliderAttachment,
-                lowPassSlopeSliderAttachment;
+    Attachment  resonanceDepthSliderAttachment,
+                resonanceThresholdSliderAttachment;
+    
+    APVTS::ButtonAttachment resonanceButtonAttachment, midSideButtonAttachment;
+    
+    //the cut filter controls switch between the main and side parameters, so their attachments are rebuilt rather than fixed.
+    std::unique_ptr<Attachment> highPassFreqSliderAttachment,
+                                lowPassFreqSliderAttachment,
+                                highPassSlopeSliderAttachment,
+                                lowPassSlopeSliderAttachment;
+    
+    //the controls of one row of peakBands, attached to that band's parameters.
+    struct PeakBandControls
+    {
+        explicit PeakBandControls(const PeakBandDescriptor& band);
+        
+        //drops the current attachments and attaches to the band's parameters under the given id prefix.
+        void attach(APVTS& apvts, const juce::String& prefix);
+        
+        const PeakBandDescriptor& band;
+        
+        CustomRotarySlider freqSlider, gainSlider;
+        CustomHorizontalBar qualitySlider;
+        juce::ToggleButton onButton;
+        
+        std::unique_ptr<Attachment> freqSliderAttachment, gainSliderAttachment, qualitySliderAttachment;
+        std::unique_ptr<APVTS::ButtonAttachment> onButtonAttachment;
+    };
+    
+    //one entry per band, in table order.
+    juce::OwnedArray<PeakBandControls> peakBandControls;
+    
+    //attaches every cut and band control to the main parameters, or to the side set.
+    void attachEqControls(bool toSide);
+    
+    //greys out mid/side for layouts other than stereo, and edit side while mid/side isn't running.
+    void updateMidSideButtons();
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
     
     
     //function that will put all the sliders in a vector so we can iterate through them easily and apply processing on them as a batch if needed.
@@ -8,6 +8,8 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "MatchEQ.h"
+#include "OutputMeter.h"
 
 //==============================================================================
 RuckusEQAudioProcessor::RuckusEQAudioProcessor()
@@ -22,6 +24,17 @@ RuckusEQAudioProcessor::RuckusEQAudioProcessor()
                        )
 #endif
 {
+    matchEQ = std::make_unique<MatchEQ>(apvts);
+    outputMeter = std::make_unique<OutputMeter>();
+    
+    resonanceOn = apvts.getRawParameterValue("Resonance Suppression");
+    resonanceDepth = apvts.getRawParameterValue("Resonance Depth");
+    resonanceThreshold = apvts.getRawParameterValue("Resonance Threshold");
+    
+    midSideOn = apvts.getRawParameterValue("Mid Side");
+    
+    sideChains.add(new MonoChain());
+    shareCoefficients(sideChains);
 }
 
 RuckusEQAudioProcessor::~RuckusEQAudioProcessor()
@@ -102,10 +115,42 @@ void RuckusEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     spec.numChannels = 1;
     spec.sampleRate = sampleRate;
     
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
+    // offline renders spread channels over the shared pool. its threads are started here rather than in processBlock, so the first block doesn't wait for them.
+    if (isNonRealtime())
+        channelThreads->startWorkers();
     
-    updateFilters();
+    // one chain of each topology per processed channel. that is every channel of a matching layout, but only one for mono-to-stereo, where the right output is a copy of the left. hosts call prepareToPlay again for every sample rate or block size change, so the chains are only rebuilt when the channel count changes.
+    auto numChannels = getNumProcessedChannels();
+    
+    if (chains.size() != numChannels)
+    {
+        chains.clear();
+        
+        for (int channel = 0; channel < numChannels; channel++)
+            chains.add(new MonoChain());
+        
+        shareCoefficients(chains);
+        
+        svfChains.assign(static_cast<size_t>(numChannels), SvfMonoChain());
+    }
+    
+    for (auto* chain : chains)
+        chain->prepare(spec);
+    
+    for (auto& chain : svfChains)
+        chain.prepare(spec);
+    
+    sideChains.getFirst()->prepare(spec);
+    sideSvfChain.prepare(spec);
+    
+    //no coefficients are designed here, processBlock brings them up to date before the first sample is processed.
+    matchEQ->prepare(sampleRate);
+    outputMeter->prepare(sampleRate, getChannelLayoutOfBus(false, 0));
+    
+    //the plain eq has no latency, only the suppressor adds its frame.
+    resonanceSuppressor.prepare(sampleRate, numChannels);
+    resonanceWasOn = resonanceOn->load() > 0.5f;
+    setLatencySamples(resonanceWasOn ? resonanceSuppressor.getLatencyInSamples() : 0);
 }
 
 void RuckusEQAudioProcessor::releaseResources()
@@ -114,6 +159,15 @@ void RuckusEQAudioProcessor::releaseResources()
     // spare memory, etc.
 }
 
+// hosts switch to offline rendering either before or after prepareToPlay, so the pool is started from both.
+void RuckusEQAudioProcessor::setNonRealtime (bool nonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime (nonRealtime);
+    
+    if (nonRealtime)
+        channelThreads->startWorkers();
+}
+
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool RuckusEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
 {
@@ -121,17 +175,17 @@ bool RuckusEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
     juce::ignoreUnused (layouts);
     return true;
   #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // every channel runs its own mono chain with the shared coefficients, so any
+    // channel count works, from mono up to immersive beds and large stems.
+    if (layouts.getMainOutputChannelSet().isDisabled())
         return false;
 
-    // This checks if the input layout matches the output layout
+    // This checks if the input layout matches the output layout. mono in, stereo out is also allowed, the mono signal is processed once and sent to both sides.
    #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+    auto isMonoToStereo = layouts.getMainInputChannelSet() == juce::AudioChannelSet::mono()
+                       && layouts.getMainOutputChannelSet() == juce::AudioChannelSet::stereo();
+    
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet() && ! isMonoToStereo)
         return false;
    #endif
 
@@ -140,6 +194,11 @@ bool RuckusEQAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 }
 #endif
 
+void RuckusEQAudioProcessor::processorLayoutsChanged()
+{
+    layoutChanges.sendChangeMessage();
+}
+
 //takes audio from the plugins input source, and feeds it through the plugins dsp.
 void RuckusEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
@@ -147,26 +206,164 @@ void RuckusEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
-    // clears any output channels that didn't contain input data
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
+    // clears any output channels that didn't contain input data. mono-to-stereo fills them after processing instead.
+    auto isMonoToStereo = totalNumInputChannels == 1 && totalNumOutputChannels > 1;
+    
+    if (! isMonoToStereo)
+    {
+        for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+            buffer.clear (i, 0, buffer.getNumSamples());
+    }
+    
+    //the match eq learns the unprocessed input.
+    matchEQ->pushInput(buffer, totalNumInputChannels);
     
     updateFilters();
+    publishResponse();
+    updateResonanceSuppressor();
     
     // points to data in the audio buffer
     juce::dsp::AudioBlock<float> block(buffer);
     
-    // extract individual left and right channels from buffer
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
+    auto numChannels = juce::jmin(buffer.getNumChannels(), chains.size());
+    auto tileSize = static_cast<size_t>(getTileSize(buffer.getNumSamples(), numActiveStages));
+    auto suppressResonances = resonanceWasOn;
+    
+    // run one channel through its mono filter chain of the selected topology, then the resonance suppressor, which only records the input while it's off.
+    // large blocks go through the whole chain one cache sized tile at a time, instead of every stage streaming the full block through the cache.
+    auto processChannel = [this, &block, tileSize, suppressResonances](int channel)
+    {
+        auto channelBlock = block.getSingleChannelBlock(static_cast<size_t>(channel));
+        auto numSamples = channelBlock.getNumSamples();
+        
+        for (size_t start = 0; start < numSamples; start += tileSize)
+        {
+            auto tile = channelBlock.getSubBlock(start, juce::jmin(tileSize, numSamples - start));
+            juce::dsp::ProcessContextReplacing<float> context(tile);
+            
+            if (activeTopology == FilterTopology::Topology_Svf)
+                svfChains[static_cast<size_t>(channel)].process(context);
+            else
+                chains.getUnchecked(channel)->process(context);
+        }
+        
+        if (suppressResonances)
+            resonanceSuppressor.process(channel, channelBlock.getChannelPointer(0), static_cast<int>(numSamples));
+        else
+            resonanceSuppressor.record(channel, channelBlock.getChannelPointer(0), static_cast<int>(numSamples));
+    };
+    
+    // mid/side couples the two channels, so they go through together. the suppressor runs on the decoded left and right. it's only ever on for a stereo pair, which is below minChannelsForParallelProcessing anyway, so offline renders take the same path. other layouts run the main settings on every channel and the editor greys the switch out.
+    // otherwise channels are independent, so when rendering offline they can be spread over all cores. in real time we stay on the host's audio thread.
+    if (midSideWasOn && numChannels == 2)
+    {
+        processMidSide(block, tileSize);
+        
+        for (int channel = 0; channel < numChannels; channel++)
+        {
+            auto* samples = block.getChannelPointer(static_cast<size_t>(channel));
+            
+            if (suppressResonances)
+                resonanceSuppressor.process(channel, samples, static_cast<int>(block.getNumSamples()));
+            else
+                resonanceSuppressor.record(channel, samples, static_cast<int>(block.getNumSamples()));
+        }
+    }
+    else if (isNonRealtime() && numChannels >= minChannelsForParallelProcessing)
+    {
+        channelThreads->parallelFor(numChannels, processChannel);
+    }
+    else
+    {
+        for (int channel = 0; channel < numChannels; channel++)
+            processChannel(channel);
+    }
+    
+    //every channel gets the same eq, so the processed mono channel is exactly what the other outputs would have computed.
+    if (isMonoToStereo)
+    {
+        for (auto i = 1; i < totalNumOutputChannels; ++i)
+            buffer.copyFrom(i, 0, buffer, 0, 0, buffer.getNumSamples());
+    }
+    
+    //meters what the host receives, so mono-to-stereo counts both outputs.
+    outputMeter->process(buffer, totalNumOutputChannels);
+}
+
+//in place, mid = (l + r) / 2 into the left channel and side = (l - r) / 2 into the right. no sample depends on another, so the compiler vectorises the loop.
+static void encodeMidSide(float* left, float* right, size_t numSamples) noexcept
+{
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto l = left[i], r = right[i];
+        left[i] = 0.5f * (l + r);
+        right[i] = 0.5f * (l - r);
+    }
+}
+
+//the inverse, l = mid + side and r = mid - side, back in place.
+static void decodeMidSide(float* mid, float* side, size_t numSamples) noexcept
+{
+    for (size_t i = 0; i < numSamples; ++i)
+    {
+        auto m = mid[i], s = side[i];
+        mid[i] = m + s;
+        side[i] = m - s;
+    }
+}
+
+//one pass over the stereo pair, a tile at a time: encode the tile in place, run mid and side through their chains, decode it in place, all while the tile is still in cache. nothing is copied, so it costs what stereo costs plus the add and subtract at each end.
+//the encode and decode stay separate loops rather than being folded into the first and last stage. the juce stages each run their own loop over the tile, and which stage comes first or last changes with the bypass flags, so folding them in would mean a second copy of every stage type. on a tile that's already in L1 the two extra loops are a handful of vector adds per sample frame.
+void RuckusEQAudioProcessor::processMidSide(juce::dsp::AudioBlock<float>& block, size_t tileSize)
+{
+    auto* left = block.getChannelPointer(0);
+    auto* right = block.getChannelPointer(1);
+    auto numSamples = block.getNumSamples();
+    
+    for (size_t start = 0; start < numSamples; start += tileSize)
+    {
+        auto length = juce::jmin(tileSize, numSamples - start);
+        encodeMidSide(left + start, right + start, length);
+        
+        auto tile = block.getSubBlock(start, length);
+        auto midTile = tile.getSingleChannelBlock(0);
+        auto sideTile = tile.getSingleChannelBlock(1);
+        juce::dsp::ProcessContextReplacing<float> midContext(midTile), sideContext(sideTile);
+        
+        if (activeTopology == FilterTopology::Topology_Svf)
+        {
+            svfChains.front().process(midContext);
+            sideSvfChain.process(sideContext);
+        }
+        else
+        {
+            chains.getFirst()->process(midContext);
+            sideChains.getFirst()->process(sideContext);
+        }
+        
+        decodeMidSide(left + start, right + start, length);
+    }
+}
+
+//only channels that carry input are filtered, extra outputs are either cleared or copies of the mono input.
+int RuckusEQAudioProcessor::getNumProcessedChannels() const
+{
+    auto numInputs = getTotalNumInputChannels();
+    auto numOutputs = getTotalNumOutputChannels();
+    
+    return numInputs > 0 ? juce::jmin(numInputs, numOutputs) : numOutputs;
+}
+
+//splits blocks larger than the tile limit into equal tiles, so there is never a short leftover tile paying the per-call overhead for a handful of samples.
+int RuckusEQAudioProcessor::getTileSize(int numSamples, int numActiveStages) noexcept
+{
+    auto maxSize = numActiveStages > manyStages ? manyStagesTileSize : maxTileSize;
     
-    // processing contexts that wrap each block
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
+    if (numSamples <= maxSize)
+        return juce::jmax(1, numSamples);
     
-    // pass contexts into mono filter chains
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    auto numTiles = (numSamples + maxSize - 1) / maxSize;
+    return (numSamples + numTiles - 1) / numTiles;
 }
 
 //==============================================================================
@@ -195,145 +392,285 @@ void RuckusEQAudioProcessor::setStateInformation (const void* data, int sizeInBy
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if(tree.isValid())
     {
+        //the filters pick the new state up at the start of the next processBlock.
         apvts.replaceState(tree);
-        updateFilters();
     }
 }
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts, const juce::String& prefix)
 {
-    ChainSettings settings;
-    
-    settings.highPassFreq = apvts.getRawParameterValue("HighPass Freq")->load();
-    settings.highPassSlope = static_cast<Slope>(apvts.getRawParameterValue("HighPass Slope")->load());
+    return ChainParameters(apvts, prefix).load();
+}
+
+ChainParameters::ChainParameters(juce::AudioProcessorValueTreeState& apvts, const juce::String& prefix)
+{
+    for (size_t band = 0; band < numPeakBands; ++band)
+    {
+        auto name = prefix + peakBands[band].name;
+        
+        peaks[band].freq = apvts.getRawParameterValue(name + " Freq");
+        peaks[band].gain = apvts.getRawParameterValue(name + " Gain");
+        peaks[band].quality = apvts.getRawParameterValue(name + " Q");
+        peaks[band].on = apvts.getRawParameterValue(name + " On");
+    }
     
-    settings.lowPassFreq = apvts.getRawParameterValue("LowPass Freq")->load();
-    settings.lowPassSlope = static_cast<Slope>(apvts.getRawParameterValue("LowPass Slope")->load());
+    highPassFreq = apvts.getRawParameterValue(prefix + "HighPass Freq");
+    highPassSlope = apvts.getRawParameterValue(prefix + "HighPass Slope");
     
-    settings.rumbleFreq = apvts.getRawParameterValue("Rumble Freq")->load();
-    settings.rumbleGainInDecibels = apvts.getRawParameterValue("Rumble Gain")->load();
-    settings.rumbleQuality = apvts.getRawParameterValue("Rumble Q")->load();
+    lowPassFreq = apvts.getRawParameterValue(prefix + "LowPass Freq");
+    lowPassSlope = apvts.getRawParameterValue(prefix + "LowPass Slope");
     
-    settings.lowFreq = apvts.getRawParameterValue("Low Freq")->load();
-    settings.lowGainInDecibels = apvts.getRawParameterValue("Low Gain")->load();
-    settings.lowQuality = apvts.getRawParameterValue("Low Q")->load();
+    topology = apvts.getRawParameterValue("Filter Topology");
+    design = apvts.getRawParameterValue("Coefficient Design");
+}
+
+ChainSettings ChainParameters::load() const noexcept
+{
+    ChainSettings settings;
     
-    settings.lowMidFreq = apvts.getRawParameterValue("LowMid Freq")->load();
-    settings.lowMidGainInDecibels = apvts.getRawParameterValue("LowMid Gain")->load();
-    settings.lowMidQuality = apvts.getRawParameterValue("LowMid Q")->load();
+    settings.highPassFreq = highPassFreq->load();
+    settings.highPassSlope = static_cast<Slope>(highPassSlope->load());
     
-    settings.highMidFreq = apvts.getRawParameterValue("HighMid Freq")->load();
-    settings.highMidGainInDecibels = apvts.getRawParameterValue("HighMid Gain")->load();
-    settings.highMidQuality = apvts.getRawParameterValue("HighMid Q")->load();
+    settings.lowPassFreq = lowPassFreq->load();
+    settings.lowPassSlope = static_cast<Slope>(lowPassSlope->load());
     
-    settings.highFreq = apvts.getRawParameterValue("High Freq")->load();
-    settings.highGainInDecibels = apvts.getRawParameterValue("High Gain")->load();
-    settings.highQuality = apvts.getRawParameterValue("High Q")->load();
+    for (size_t band = 0; band < numPeakBands; ++band)
+    {
+        settings.peaks[band].freq = peaks[band].freq->load();
+        settings.peaks[band].gainInDecibels = peaks[band].gain->load();
+        settings.peaks[band].quality = peaks[band].quality->load();
+        settings.peaks[band].isOn = peaks[band].on->load() > 0.5f;
+    }
     
-    settings.airFreq = apvts.getRawParameterValue("Air Freq")->load();
-    settings.airGainInDecibels = apvts.getRawParameterValue("Air Gain")->load();
-    settings.airQuality = apvts.getRawParameterValue("Air Q")->load();
+    settings.topology = static_cast<FilterTopology>(topology->load());
+    settings.design = static_cast<CoefficientDesign>(design->load());
     
     return settings;
 }
 
-Coefficients makeRumbleFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, chainSettings.rumbleFreq, chainSettings.rumbleQuality, juce::Decibels::decibelsToGain(chainSettings.rumbleGainInDecibels));
-}
-Coefficients makeLowFilter(const ChainSettings& chainSettings, double sampleRate)
+//the biquad chains all reference the first chain's coefficient objects, so every design is written into that one only. updateFilters copies its bypass flags to the others.
+void RuckusEQAudioProcessor::updateBandPassFilter(const ChainSettings & chainSettings)
 {
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, chainSettings.lowFreq, chainSettings.lowQuality, juce::Decibels::decibelsToGain(chainSettings.lowGainInDecibels));
+    updatePeakFilters(*chains.getFirst(), makePeakFilters(chainSettings, getSampleRate()), chainSettings);
 }
-Coefficients makeLowMidFilter(const ChainSettings& chainSettings, double sampleRate)
+
+//every chain of a topology runs the same coefficients, so the first one speaks for all of them. in mid/side mode it's the mid chain, and the side chain is published next to it.
+void RuckusEQAudioProcessor::publishResponse()
 {
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, chainSettings.lowMidFreq, chainSettings.lowMidQuality, juce::Decibels::decibelsToGain(chainSettings.lowMidGainInDecibels));
+    if (activeTopology == FilterTopology::Topology_Svf)
+    {
+        if (svfChains.empty())
+            return;
+        
+        captureResponse(svfChains.front(), getSampleRate(), activeResponse);
+        
+        if (midSideWasOn)
+            captureResponse(sideSvfChain, getSampleRate(), activeSideResponse);
+    }
+    else
+    {
+        if (chains.isEmpty())
+            return;
+        
+        captureResponse(*chains.getFirst(), getSampleRate(), activeResponse);
+        
+        if (midSideWasOn)
+            captureResponse(*sideChains.getFirst(), getSampleRate(), activeSideResponse);
+    }
+    
+    publishedResponse.publish(activeResponse);
+    
+    if (midSideWasOn)
+        publishedSideResponse.publish(activeSideResponse);
 }
-Coefficients makeHighMidFilter(const ChainSettings& chainSettings, double sampleRate)
+
+//switching the suppressor on carries on from the input it recorded while it was off, so the output continues as the input delayed by a frame, and the reductions build up from there.
+//the latency changes with the switch. the plugin wrappers hand the change to the message thread, the host realigns when it picks it up.
+void RuckusEQAudioProcessor::updateResonanceSuppressor()
 {
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, chainSettings.highMidFreq, chainSettings.highMidQuality, juce::Decibels::decibelsToGain(chainSettings.highMidGainInDecibels));
+    auto isOn = resonanceOn->load() > 0.5f;
+    
+    if (isOn != resonanceWasOn)
+    {
+        if (isOn)
+            resonanceSuppressor.start();
+        
+        resonanceWasOn = isOn;
+        setLatencySamples(isOn ? resonanceSuppressor.getLatencyInSamples() : 0);
+    }
+    
+    resonanceSuppressor.setParameters(resonanceDepth->load(), resonanceThreshold->load());
 }
-Coefficients makeHighFilter(const ChainSettings& chainSettings, double sampleRate)
+
+void RuckusEQAudioProcessor::updateHighPassFilters(const ChainSettings &chainSettings)
 {
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, chainSettings.highFreq, chainSettings.highQuality, juce::Decibels::decibelsToGain(chainSettings.highGainInDecibels));
+    updatePassFilter(chains.getFirst()->get<ChainPositions::highPass>(), makeHighPassFilter(chainSettings, getSampleRate()), chainSettings.highPassSlope);
 }
-Coefficients makeAirFilter(const ChainSettings& chainSettings, double sampleRate)
+
+void RuckusEQAudioProcessor::updateLowPassFilters(const ChainSettings &chainSettings)
 {
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, chainSettings.airFreq, chainSettings.airQuality, juce::Decibels::decibelsToGain(chainSettings.airGainInDecibels));
+    updatePassFilter(chains.getFirst()->get<ChainPositions::lowPass>(), makeLowPassFilter(chainSettings, getSampleRate()), chainSettings.lowPassSlope);
 }
 
-void RuckusEQAudioProcessor::updateBandPassFilter(const ChainSettings & chainSettings)
+void RuckusEQAudioProcessor::updateSvfFilters(const ChainSettings &chainSettings)
 {
-    //rumble
-    auto rumbleCoefficients = makeRumbleFilter(chainSettings, getSampleRate());
+    auto sampleRate = getSampleRate();
     
-    updateCoefficients(leftChain.get<ChainPositions::rumble>().coefficients, rumbleCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::rumble>().coefficients, rumbleCoefficients);
+    auto peakCoefficients = makeSvfPeakFilters(chainSettings, sampleRate);
+    for (auto& chain : svfChains)
+        updatePeakFilters(chain, peakCoefficients, chainSettings);
     
-    //lows
-    auto lowCoefficients = makeLowFilter(chainSettings, getSampleRate());
+    auto highPassCoefficients = makeSvfHighPassFilter(chainSettings, sampleRate);
+    for (auto& chain : svfChains)
+        updatePassFilter(chain.get<ChainPositions::highPass>(), highPassCoefficients, chainSettings.highPassSlope);
     
-    updateCoefficients(leftChain.get<ChainPositions::low>().coefficients, lowCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::low>().coefficients, lowCoefficients);
+    auto lowPassCoefficients = makeSvfLowPassFilter(chainSettings, sampleRate);
+    for (auto& chain : svfChains)
+        updatePassFilter(chain.get<ChainPositions::lowPass>(), lowPassCoefficients, chainSettings.lowPassSlope);
+}
+
+//updateMonoChain takes the fast design path for these settings. like the exact path, it's written into the first chain only.
+void RuckusEQAudioProcessor::updateFastFilters(const ChainSettings &chainSettings)
+{
+    updateMonoChain(*chains.getFirst(), chainSettings, getSampleRate());
+}
+
+//the side chain designs through the same functions as the main chains, it just has nobody to share its coefficients with.
+void RuckusEQAudioProcessor::updateSideFilters(const ChainSettings& sideSettings)
+{
+    if (activeTopology == FilterTopology::Topology_Svf)
+        updateMonoChain(sideSvfChain, sideSettings, getSampleRate());
+    else
+        updateMonoChain(*sideChains.getFirst(), sideSettings, getSampleRate());
+}
+
+static int getNumActiveStages(const ChainSettings& chainSettings)
+{
+    auto numStages = chainSettings.highPassSlope + 1 + chainSettings.lowPassSlope + 1;
     
-    //low-mids
-    auto lowMidCoefficients = makeLowMidFilter(chainSettings, getSampleRate());
+    for (const auto& peak : chainSettings.peaks)
+        numStages += peak.isOn ? 1 : 0;
     
-    updateCoefficients(leftChain.get<ChainPositions::lowMid>().coefficients, lowMidCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::lowMid>().coefficients, lowMidCoefficients);
+    return numStages;
+}
+
+void RuckusEQAudioProcessor::updateFilters()
+{
+    //nothing to design into before the first prepareToPlay.
+    if (chains.isEmpty())
+        return;
+    
+    auto chainSettings = chainParameters.load();
     
-    //high-mids
-    auto highMidCoefficients = makeHighMidFilter(chainSettings, getSampleRate());
+    numActiveStages = getNumActiveStages(chainSettings);
     
-    updateCoefficients(leftChain.get<ChainPositions::highMid>().coefficients, highMidCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::highMid>().coefficients, highMidCoefficients);
+    //mid/side needs exactly one left and one right channel, see canProcessMidSide.
+    auto isMidSide = midSideOn->load() > 0.5f && chains.size() == 2;
     
-    //highs
-    auto highCoefficients = makeHighFilter(chainSettings, getSampleRate());
+    //clear the state of the chains taking over so they don't start from whatever they held the last time they were active. switching mid/side changes what the chains' state holds, so that clears it as well.
+    if (chainSettings.topology != activeTopology || isMidSide != midSideWasOn)
+    {
+        if (chainSettings.topology == FilterTopology::Topology_Svf)
+        {
+            for (auto& chain : svfChains)
+                chain.reset();
+            
+            sideSvfChain.reset();
+        }
+        else
+        {
+            for (auto* chain : chains)
+                chain->reset();
+            
+            sideChains.getFirst()->reset();
+        }
+        
+        activeTopology = chainSettings.topology;
+        midSideWasOn = isMidSide;
+    }
     
-    updateCoefficients(leftChain.get<ChainPositions::high>().coefficients, highCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::high>().coefficients, highCoefficients);
+    //only design coefficients for the topology that is actually running.
+    if (activeTopology == FilterTopology::Topology_Svf)
+    {
+        updateSvfFilters(chainSettings);
+    }
+    else if (chainSettings.design == CoefficientDesign::Design_Fast)
+    {
+        updateFastFilters(chainSettings);
+    }
+    else
+    {
+        updateHighPassFilters(chainSettings);
+        updateBandPassFilter(chainSettings);
+        updateLowPassFilters(chainSettings);
+    }
     
-    //air
-    auto airCoefficients = makeAirFilter(chainSettings, getSampleRate());
+    if (activeTopology == FilterTopology::Topology_Biquad)
+    {
+        for (int channel = 1; channel < chains.size(); channel++)
+            copyBypassFlags(*chains.getFirst(), *chains.getUnchecked(channel));
+    }
     
-    updateCoefficients(leftChain.get<ChainPositions::air>().coefficients, airCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::air>().coefficients, airCoefficients);
-}
-
-void updateCoefficients(Coefficients& old, const Coefficients &replacements)
-{
-    *old = *replacements;
+    //the tiles are sized for whichever of mid and side runs more stages.
+    if (midSideWasOn)
+    {
+        auto sideSettings = sideParameters.load();
+        numActiveStages = juce::jmax(numActiveStages, getNumActiveStages(sideSettings));
+        updateSideFilters(sideSettings);
+    }
 }
 
-void RuckusEQAudioProcessor::updateHighPassFilters(const ChainSettings &chainSettings)
+//the cut filters and the freq/gain/q triple of every band, under the given id prefix. mid/side adds a second set for the side.
+static void addEqParameters(juce::AudioProcessorValueTreeState::ParameterLayout& layout, const juce::String& prefix)
 {
-    auto highPassCoefficients = makeHighPassFilter(chainSettings, getSampleRate());
+    juce::StringArray filterSlopes;
+    for (int i = 0; i < 4; i++) {
+        juce::String slope;
+        slope << (12 + i*12);
+        slope << " dB/Oct";
+        filterSlopes.add(slope);
+    }
     
-    auto& leftHighPass = leftChain.get<ChainPositions::highPass>();
-    updatePassFilter(leftHighPass, highPassCoefficients, chainSettings.highPassSlope);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(prefix + "HighPass Freq", 1),
+                                                           prefix + "HighPass Freq",
+                                                           juce::NormalisableRange<float>(10.f, 500.f, 1.f, 0.9f),
+                                                           10.f));
     
-    auto& rightHighPass = rightChain.get<ChainPositions::highPass>();
-    updatePassFilter(rightHighPass, highPassCoefficients, chainSettings.highPassSlope);
-}
-
-void RuckusEQAudioProcessor::updateLowPassFilters(const ChainSettings &chainSettings)
-{
-    auto lowPassCoefficients = makeLowPassFilter(chainSettings, getSampleRate());
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID(prefix + "HighPass Slope", 1), prefix + "HighPass Slope", filterSlopes, 0));
     
-    auto& leftLowPass = leftChain.get<ChainPositions::lowPass>();
-    updatePassFilter(leftLowPass, lowPassCoefficients, chainSettings.lowPassSlope);
-
-    auto& rightLowPass = rightChain.get<ChainPositions::lowPass>();
-    updatePassFilter(rightLowPass, lowPassCoefficients, chainSettings.lowPassSlope);
+    layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(prefix + "LowPass Freq", 1),
+                                                           prefix + "LowPass Freq",
+                                                           juce::NormalisableRange<float>(3000.f, 21000.f, 1.f, 0.4f),
+                                                           21000.f));
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID(prefix + "LowPass Slope", 1), prefix + "LowPass Slope", filterSlopes, 0));
+    
+    //one freq/gain/q triple per row of the band table, in table order.
+    for (const auto& band : peakBands)
+    {
+        auto name = prefix + band.name;
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name + " Freq", 1),
+                                                               name + " Freq",
+                                                               juce::NormalisableRange<float>(band.minFreq, band.maxFreq, 1.f, band.freqSkew),
+                                                               band.defaultFreq));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name + " Gain", 1),
+                                                               name + " Gain",
+                                                               juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
+                                                               0.0f));
+        
+        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID(name + " Q", 1),
+                                                               name + " Q",
+                                                               juce::NormalisableRange<float>(0.1f, band.maxQuality, 0.05f, 1.f),
+                                                               1.f));
+    }
 }
 
-void RuckusEQAudioProcessor::updateFilters()
+static void addBandSwitches(juce::AudioProcessorValueTreeState::ParameterLayout& layout, const juce::String& prefix)
 {
-    auto chainSettings = getChainSettings(apvts);
-    updateHighPassFilters(chainSettings);
-    updateBandPassFilter(chainSettings);
-    updateLowPassFilters(chainSettings);
+    for (const auto& band : peakBands)
+        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID(prefix + band.name + " On", 1), prefix + band.name + " On", band.isOnByDefault));
 }
 
 //sets up all of the configurable parameters in the plugin to be passed into the audio processor value tree state constructor.
@@ -342,123 +679,35 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 {
         juce::AudioProcessorValueTreeState::ParameterLayout layout;
        
-        juce::StringArray filterSlopes;
-        for (int i = 0; i < 4; i++) {
-            juce::String slope;
-            slope << (12 + i*12);
-            slope << " dB/Oct";
-            filterSlopes.add(slope);
-        }
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("HighPass Freq", 1),
-                                                               "HighPass Freq",
-                                                               juce::NormalisableRange<float>(10.f, 500.f, 1.f, 0.9f),
-                                                               10.f));
-        
-        layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("HighPass Slope", 1), "HighPass Slope", filterSlopes, 0));
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("LowPass Freq", 1),
-                                                               "LowPass Freq",
-                                                               juce::NormalisableRange<float>(3000.f, 21000.f, 1.f, 0.4f),
-                                                               21000.f));
-        
-        layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("LowPass Slope", 1), "LowPass Slope", filterSlopes, 0));
-        
-        //Rumble
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Rumble Freq", 1),
-                                                               "Rumble Freq",
-                                                               juce::NormalisableRange<float>(20.f, 200.f, 1.f, 0.9f),
-                                                               75.f));
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Rumble Gain", 1),
-                                                               "Rumble Gain",
-                                                               juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
-                                                               0.0f));
+        addEqParameters(layout, {});
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Rumble Q", 1),
-                                                               "Rumble Q",
-                                                               juce::NormalisableRange<float>(0.1f, 3.4f, 0.05f, 1.f),
-                                                               1.f));
-        
-        //Lows
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Low Freq", 1),
-                                                               "Low Freq",
-                                                               juce::NormalisableRange<float>(150.f, 400.f, 1.f, 0.85f),
-                                                               250.f));
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Low Gain", 1),
-                                                               "Low Gain",
-                                                               juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
-                                                               0.0f));
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Low Q", 1),
-                                                               "Low Q",
-                                                               juce::NormalisableRange<float>(0.1f, 3.4f, 0.05f, 1.f),
-                                                               1.f));
-        
-        //Low-mids
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("LowMid Freq", 1),
-                                                               "LowMid Freq",
-                                                               juce::NormalisableRange<float>(350.f, 1500.f, 1.f, 0.8f),
-                                                               250.f));
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("LowMid Gain", 1),
-                                                               "LowMid Gain",
-                                                               juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
-                                                               0.0f));
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("LowMid Q", 1),
-                                                               "LowMid Q",
-                                                               juce::NormalisableRange<float>(0.1f, 3.4f, 0.05f, 1.f),
-                                                               1.f));
-        
-        //High-mids
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("HighMid Freq", 1),
-                                                               "HighMid Freq",
-                                                               juce::NormalisableRange<float>(1000.f, 6000.f, 1.f, 0.65f),
-                                                               250.f));
-        
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("HighMid Gain", 1),
-                                                               "HighMid Gain",
-                                                               juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
-                                                               0.0f));
+        //filter structure, svf is better suited to heavy automation
+        layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Filter Topology", 1), "Filter Topology", juce::StringArray { "Biquad", "SVF" }, 0));
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("HighMid Q", 1),
-                                                               "HighMid Q",
-                                                               juce::NormalisableRange<float>(0.1f, 3.4f, 0.05f, 1.f),
-                                                               1.f));
+        //polynomial approximations instead of std trig/pow when designing coefficients, for automation heavy sessions
+        layout.add(std::make_unique<juce::AudioParameterChoice>(juce::ParameterID("Coefficient Design", 1), "Coefficient Design", juce::StringArray { "Exact", "Fast" }, 0));
         
-        //Highs
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("High Freq", 1),
-                                                               "High Freq",
-                                                               juce::NormalisableRange<float>(5000.f, 16000.f, 1.f, 0.5f),
-                                                               250.f));
+        //band switches come last so the parameter order existing sessions were saved with doesn't move.
+        addBandSwitches(layout, {});
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("High Gain", 1),
-                                                               "High Gain",
-                                                               juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
-                                                               0.0f));
+        //adaptive resonance suppression after the eq. depth is the most any frequency is turned down, threshold is how far it has to stick out of the spectrum around it first.
+        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("Resonance Suppression", 1), "Resonance Suppression", false));
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("High Q", 1),
-                                                               "High Q",
-                                                               juce::NormalisableRange<float>(0.1f, 2.f, 0.05f, 1.f),
-                                                               1.f));
+        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Resonance Depth", 1),
+                                                               "Resonance Depth",
+                                                               juce::NormalisableRange<float>(0.f, 18.f, 0.5f, 1.f),
+                                                               6.f));
         
-        //Air
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Air Freq", 1),
-                                                               "Air Freq",
-                                                               juce::NormalisableRange<float>(14000.f, 22000.f, 1.f, 0.45f),
-                                                               250.f));
+        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Resonance Threshold", 1),
+                                                               "Resonance Threshold",
+                                                               juce::NormalisableRange<float>(3.f, 24.f, 0.5f, 1.f),
+                                                               9.f));
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Air Gain", 1),
-                                                               "Air Gain",
-                                                               juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
-                                                               0.0f));
+        //mid/side mode for stereo layouts: the main parameters eq the mid signal and the side set below eqs the side. the side set starts flat like the main one.
+        layout.add(std::make_unique<juce::AudioParameterBool>(juce::ParameterID("Mid Side", 1), "Mid/Side", false));
         
-        layout.add(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID("Air Q", 1),
-                                                               "Air Q",
-                                                               juce::NormalisableRange<float>(0.1f, 1.2f, 0.05f, 1.f),
-                                                               1.f));
+        addEqParameters(layout, sideParameterPrefix);
+        addBandSwitches(layout, sideParameterPrefix);
         
         return layout;
 }
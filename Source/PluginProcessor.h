@@ -9,122 +9,37 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "FilterChain.h"
+#include "ChannelThreadPool.h"
+#include "ResonanceSuppressor.h"
 
-enum Slope
-{
-    Slope_12,
-    Slope_24,
-    Slope_36,
-    Slope_48
-};
-
-// extract parameters from audio processor value tree state, create a data structure representing all parameter values.
-struct ChainSettings
-{
-    //Rumble 20Hz-200Hz
-    float rumbleFreq { 0 }, rumbleGainInDecibels{ 0 }, rumbleQuality {1.f};
-    
-    //Lows 150Hz-400Hz
-    float lowFreq { 0 }, lowGainInDecibels{ 0 }, lowQuality {1.f};
-    
-    //Low-Mids 0.35kHz-1.5kHz
-    float lowMidFreq { 0 }, lowMidGainInDecibels{ 0 }, lowMidQuality {1.f};
-    
-    //High-Mids 1kHz-6kHz
-    float highMidFreq { 0 }, highMidGainInDecibels{ 0 }, highMidQuality {1.f};
-    
-    //Highs 5kHz-16kHz
-    float highFreq { 0 }, highGainInDecibels{ 0 }, highQuality {1.f};
-    
-    //Air 12kHz-22kHz
-    float airFreq { 0 }, airGainInDecibels{ 0 }, airQuality {1.f};
-    
-    float highPassFreq { 0 }, lowPassFreq { 0 };
-    Slope highPassSlope { Slope::Slope_12 }, lowPassSlope { Slope::Slope_12 };
-};
+class OutputMeter;
 
-// define helper function that will give us all parameter values in the data struct
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts);
+class MatchEQ;
 
-//create Filter type alias to make code cleaner
-//filter has a response of 12 dB/Oct when it's configured as a HPF or LPF
-using Filter = juce::dsp::IIR::Filter<float>;
+// define helper function that will give us all parameter values in the data struct. an empty prefix reads the main set, sideParameterPrefix the side set.
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts, const juce::String& prefix = {});
 
-//to do dsp in juce we need to create a series of processing, defined as a processing chain, and then pass a context through it.
-//if we use four 12 dB/Oct filters, we can create a 48 dB/Oct filter.
-using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-
-//the entire mono signal path is HPF -> rumble -> low -> lowMid -> highMid -> high -> air -> LPF
-using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, Filter, Filter, Filter, Filter, Filter, CutFilter>;
-
-enum ChainPositions
+//the raw parameter values behind ChainSettings, looked up once so the audio thread can read the settings without searching the apvts by name every block.
+class ChainParameters
 {
-    highPass,
-    rumble,
-    low,
-    lowMid,
-    highMid,
-    high,
-    air,
-    lowPass
-};
-
-using Coefficients = Filter::CoefficientsPtr;
-void updateCoefficients(Coefficients& old, const Coefficients& replacements);
-
-Coefficients makeRumbleFilter(const ChainSettings& chainSettings, double sampleRate);
-Coefficients makeLowFilter(const ChainSettings& chainSettings, double sampleRate);
-Coefficients makeLowMidFilter(const ChainSettings& chainSettings, double sampleRate);
-Coefficients makeHighMidFilter(const ChainSettings& chainSettings, double sampleRate);
-Coefficients makeHighFilter(const ChainSettings& chainSettings, double sampleRate);
-Coefficients makeAirFilter(const ChainSettings& chainSettings, double sampleRate);
-
-template<int index, typename ChainType, typename CoefficientType>
-void update(ChainType& chain, const CoefficientType& coefficients)
-{
-    updateCoefficients(chain.template get<index>().coefficients, coefficients[index]);
-    chain.template setBypassed<index>(false);
-}
-
-template<typename ChainType, typename CoefficientType>
-void updatePassFilter(ChainType& chain, const CoefficientType& coefficients, const Slope& slope)
-{
-    chain.template setBypassed<0>(true);
-    chain.template setBypassed<1>(true);
-    chain.template setBypassed<2>(true);
-    chain.template setBypassed<3>(true);
+public:
+    explicit ChainParameters(juce::AudioProcessorValueTreeState& apvts, const juce::String& prefix = {});
     
-    switch(slope)
+    ChainSettings load() const noexcept;
+    
+private:
+    struct PeakParameters
     {
-        case Slope_48:
-        {
-            update<3>(chain, coefficients);
-        }
-        case Slope_36:
-        {
-            update<2>(chain, coefficients);
-        }
-        case Slope_24:
-        {
-            update<1>(chain, coefficients);
-        }
-        case Slope_12:
-        {
-            update<0>(chain, coefficients);
-        }
-    }
-}
-
-//since we're using this function in both pluginProcessor and pluginEditor, use inline keyword. otherwise compiler will create a definition for this function everywhere the header file is included and the linker will not know which compiled cpp file to use for the definition.
-inline auto makeHighPassFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.highPassFreq, sampleRate, 2*(chainSettings.highPassSlope + 1));
-}
-
-inline auto makeLowPassFilter(const ChainSettings& chainSettings, double sampleRate)
-{
-    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.lowPassFreq, sampleRate, 2*(chainSettings.lowPassSlope + 1));
-}
+        std::atomic<float>* freq;
+        std::atomic<float>* gain;
+        std::atomic<float>* quality;
+        std::atomic<float>* on;
+    };
+    
+    std::array<PeakParameters, numPeakBands> peaks;
+    std::atomic<float>* highPassFreq, * highPassSlope, * lowPassFreq, * lowPassSlope, * topology, * design;
+};
 
 //==============================================================================
 /**
@@ -139,10 +54,13 @@ public:
     //==============================================================================
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
+    void setNonRealtime (bool nonRealtime) noexcept override;
 
    #ifndef JucePlugin_PreferredChannelConfigurations
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
    #endif
+    
+    void processorLayoutsChanged() override;
 
     void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
@@ -174,10 +92,83 @@ public:
     
     //contains a value tree that is used to manage an audio processors entire state. connects audio parameters to gui.
     juce::AudioProcessorValueTreeState apvts {*this, nullptr, "Parameters", createParameterLayout()};
+    
+    //fits the eq to a reference track, driven by the editor.
+    MatchEQ& getMatchEQ() noexcept { return *matchEQ; }
+    
+    //the coefficients processBlock is running, republished whenever they change. the editor draws from this instead of designing its own copy.
+    PublishedChainResponse& getPublishedResponse() noexcept { return publishedResponse; }
+    
+    //the same for the side chain, only published while mid/side mode is running. in that mode the main response is the mid chain's.
+    PublishedChainResponse& getPublishedSideResponse() noexcept { return publishedSideResponse; }
+    
+    //peak, rms and loudness of the output, polled by the editor.
+    OutputMeter& getOutputMeter() noexcept { return *outputMeter; }
+    
+    //mid/side mode needs one left and one right channel. with any other layout the switch does nothing and every channel runs the main settings.
+    bool canProcessMidSide() const { return getNumProcessedChannels() == 2; }
+    
+    //sends a change message whenever the bus layout changes, so the editor can grey out what the new layout doesn't support.
+    juce::ChangeBroadcaster& getLayoutChanges() noexcept { return layoutChanges; }
 
 private:
-    //two instances of mono to create stereo.
-    MonoChain leftChain, rightChain;
+    //apvts values behind the chain settings, read once per block.
+    ChainParameters chainParameters { apvts };
+    
+    //one mono chain per channel so any channel layout works. every chain points at the first one's coefficient objects, so extra channels only add filter state.
+    juce::OwnedArray<MonoChain> chains;
+    
+    //same signal path built from svf stages, only the chains matching activeTopology are updated and processed. svf stages hold no heap memory, so they sit in one contiguous block.
+    std::vector<SvfMonoChain> svfChains;
+    FilterTopology activeTopology { FilterTopology::Topology_Biquad };
+    
+    //spreads channels across cores when the host is rendering offline.
+    juce::SharedResourcePointer<ChannelThreadPool> channelThreads;
+    
+    //below this many channels the hand-off to the workers costs more than it saves.
+    static constexpr int minChannelsForParallelProcessing = 4;
+    
+    //stages that actually run: the peak bands that are on plus one per active cut filter section. picks the tile size for large blocks.
+    int numActiveStages { static_cast<int>(numPeakBands) + 2 };
+    
+    //largest tile handed to a chain in one go. 4096 floats is 16 KB, half a typical 32 KB L1 data cache, the rest is left for the stage state and whatever else the host has resident.
+    static constexpr int maxTileSize = 4096;
+    
+    //with many stages each sample is revisited more often per tile, so smaller tiles keep it resident for the whole chain.
+    static constexpr int manyStagesTileSize = 2048;
+    static constexpr int manyStages = 10;
+    
+    static int getTileSize(int numSamples, int numActiveStages) noexcept;
+    
+    int getNumProcessedChannels() const;
+    
+    std::unique_ptr<MatchEQ> matchEQ;
+    std::unique_ptr<OutputMeter> outputMeter;
+    
+    //optional stft stage after the chains. it delays the output by a frame while it's on and not at all while it's off, the reported latency follows the switch.
+    ResonanceSuppressor resonanceSuppressor;
+    std::atomic<float>* resonanceOn { nullptr }, * resonanceDepth { nullptr }, * resonanceThreshold { nullptr };
+    bool resonanceWasOn { false };
+    
+    void updateResonanceSuppressor();
+    
+    //mid/side mode, stereo layouts only. the first chain of the active topology runs mid with the main parameters, these run side with the side parameters and coefficients of their own.
+    //the side biquad chain sits in an array of one so shareCoefficients gives it the same passthrough start as the others.
+    ChainParameters sideParameters { apvts, sideParameterPrefix };
+    std::atomic<float>* midSideOn { nullptr };
+    juce::OwnedArray<MonoChain> sideChains;
+    SvfMonoChain sideSvfChain;
+    bool midSideWasOn { false };
+    
+    juce::ChangeBroadcaster layoutChanges;
+    
+    void updateSideFilters(const ChainSettings& sideSettings);
+    void processMidSide(juce::dsp::AudioBlock<float>& block, size_t tileSize);
+    
+    PublishedChainResponse publishedResponse, publishedSideResponse;
+    ChainResponse activeResponse, activeSideResponse;
+    
+    void publishResponse();
     
     //functions below prevent repeating blocks of code in prepareToPlay and processBlock.
     void updateBandPassFilter(const ChainSettings& chainSettings);
@@ -185,6 +176,9 @@ private:
     void updateHighPassFilters(const ChainSettings& chainSettings);
     void updateLowPassFilters(const ChainSettings& chainSettings);
     
+    void updateSvfFilters(const ChainSettings& chainSettings);
+    void updateFastFilters(const ChainSettings& chainSettings);
+    
     void updateFilters();
     
     //==============================================================================
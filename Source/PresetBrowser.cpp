@@ -0,0 +1,356 @@
+/*
+  ==============================================================================
+
+    PresetBrowser.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "PresetBrowser.h"
+#include "MagnitudeBatch.h"
+
+namespace
+{
+    //the version is bumped whenever the thumbnail math changes, so older cache files are designed again instead of drawn.
+    constexpr int thumbnailFileMagic = 0x48545152; // "RQTH"
+    constexpr int thumbnailFileVersion = 1;
+    constexpr juce::int64 thumbnailFileSize = 3 * sizeof(int) + PresetThumbnailCache::numThumbnailPoints * sizeof(float);
+
+    //64 bit FNV-1a of the blob, with its size alongside. plenty to tell a few thousand presets apart without pulling in a crypto module.
+    juce::String getContentKey(const juce::MemoryBlock& data)
+    {
+        auto* bytes = static_cast<const juce::uint8*>(data.getData());
+        juce::uint64 hash = 14695981039346656037ull;
+
+        for (size_t i = 0; i < data.getSize(); ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+
+        return juce::String::toHexString(static_cast<juce::int64>(hash)).paddedLeft('0', 16) + "-" + juce::String(static_cast<juce::int64>(data.getSize()));
+    }
+
+    bool readThumbnail(const juce::File& file, PresetThumbnailCache::Thumbnail& thumbnail)
+    {
+        juce::FileInputStream stream(file);
+
+        if (! stream.openedOk() || stream.getTotalLength() != thumbnailFileSize)
+            return false;
+
+        if (stream.readInt() != thumbnailFileMagic || stream.readInt() != thumbnailFileVersion
+            || stream.readInt() != PresetThumbnailCache::numThumbnailPoints)
+            return false;
+
+        thumbnail.resize(PresetThumbnailCache::numThumbnailPoints);
+
+        for (auto& value : thumbnail)
+            value = stream.readFloat();
+
+        return true;
+    }
+
+    //written next to the target and moved over it, so a browser in another instance never reads half a file.
+    void writeThumbnail(const juce::File& file, const PresetThumbnailCache::Thumbnail& thumbnail)
+    {
+        juce::TemporaryFile temporary(file);
+
+        {
+            juce::FileOutputStream stream(temporary.getFile());
+
+            if (! stream.openedOk())
+                return;
+
+            stream.writeInt(thumbnailFileMagic);
+            stream.writeInt(thumbnailFileVersion);
+            stream.writeInt(static_cast<int>(thumbnail.size()));
+
+            for (auto value : thumbnail)
+                stream.writeFloat(value);
+
+            if (! stream.flush())
+                return;
+        }
+
+        temporary.overwriteTargetFileWithTemporary();
+    }
+}
+
+PresetThumbnailCache::PresetThumbnailCache()
+    : cacheDirectory(juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("RuckusEQ").getChildFile("ThumbnailCache")),
+pool(juce::jmax(1, juce::SystemStats::getNumCpus() - 1), 0, juce::Thread::Priority::low)
+{
+    cacheDirectory.createDirectory();
+}
+
+PresetThumbnailCache::~PresetThumbnailCache()
+{
+    //jobs only take a few milliseconds, so the wait here is at most one thumbnail per thread.
+    pool.removeAllJobs(true, 2000);
+}
+
+juce::File PresetThumbnailCache::getDefaultPresetDirectory()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("RuckusEQ").getChildFile("Presets");
+}
+
+void PresetThumbnailCache::scan(const juce::File& directory, std::function<void(juce::Array<PresetInfo>)> onScanned)
+{
+    pool.addJob([directory, onScanned = std::move(onScanned)]
+    {
+        juce::Array<PresetInfo> presets;
+
+        for (const auto& file : directory.findChildFiles(juce::File::findFiles, true, juce::String("*") + presetFileExtension))
+            presets.add({ file, file.getLastModificationTime() });
+
+        std::sort(presets.begin(), presets.end(), [](const PresetInfo& a, const PresetInfo& b)
+        {
+            return a.file.getFileName().compareNatural(b.file.getFileName()) < 0;
+        });
+
+        juce::MessageManager::callAsync([onScanned, presets = std::move(presets)] { onScanned(presets); });
+    });
+}
+
+const PresetThumbnailCache::Thumbnail* PresetThumbnailCache::getThumbnail(const PresetInfo& preset)
+{
+    auto path = preset.file.getFullPathName();
+    auto found = entries.find(path);
+
+    if (found != entries.end() && found->second.modified == preset.modified)
+        return found->second.isReady ? &found->second.thumbnail : nullptr;
+
+    //not asked for yet, or the file changed since. the entry marks it as queued so it isn't queued twice.
+    entries[path] = Entry { preset.modified, {}, false };
+
+    juce::WeakReference<PresetThumbnailCache> weakThis(this);
+
+    pool.addJob([weakThis, file = preset.file, modified = preset.modified, cacheDirectory = cacheDirectory]
+    {
+        Thumbnail thumbnail;
+        juce::MemoryBlock state;
+
+        if (file.loadFileAsData(state))
+        {
+            auto cacheFile = cacheDirectory.getChildFile(getContentKey(state) + ".thumbnail");
+
+            if (! readThumbnail(cacheFile, thumbnail))
+            {
+                thumbnail.clear();
+
+                if (computeThumbnail(state, thumbnail))
+                    writeThumbnail(cacheFile, thumbnail);
+            }
+        }
+
+        juce::MessageManager::callAsync([weakThis, path = file.getFullPathName(), modified, thumbnail = std::move(thumbnail)]() mutable
+        {
+            if (auto* cache = weakThis.get())
+                cache->thumbnailArrived(path, modified, std::move(thumbnail));
+        });
+    });
+
+    return nullptr;
+}
+
+void PresetThumbnailCache::thumbnailArrived(const juce::String& path, juce::Time modified, Thumbnail thumbnail)
+{
+    auto found = entries.find(path);
+
+    //a thumbnail of content the file no longer has is dropped. one whose entry was cancelled while it was running is still good.
+    if (found != entries.end() && found->second.modified != modified)
+        return;
+
+    entries[path] = Entry { modified, std::move(thumbnail), true };
+
+    sendChangeMessage();
+}
+
+void PresetThumbnailCache::cancelPendingWork()
+{
+    pool.removeAllJobs(false, 0);
+
+    //whatever was still queued has to be queued again when it's next asked for. jobs that were already running still report back.
+    for (auto it = entries.begin(); it != entries.end();)
+        it = it->second.isReady ? std::next(it) : entries.erase(it);
+}
+
+//the same path the editor's curve takes when it designs without the processor: the biquad design of the settings, captured as sections and evaluated on the editor's frequency axis. svf presets draw the same, the two topologies have the same response. for mid/side presets this is the mid eq.
+bool PresetThumbnailCache::computeThumbnail(const juce::MemoryBlock& state, Thumbnail& thumbnail)
+{
+    auto tree = juce::ValueTree::readFromData(state.getData(), state.getSize());
+
+    if (! tree.isValid() || ! tree.hasType("Parameters"))
+        return false;
+
+    //parameters a preset doesn't mention are drawn at their defaults.
+    auto settings = getDefaultChainSettings();
+
+    for (const auto& child : tree)
+    {
+        if (child.hasType("PARAM") && child.hasProperty("id") && child.hasProperty("value"))
+            applyChainParameter(settings, child["id"].toString(), static_cast<float>(child["value"]));
+    }
+
+    MonoChain chain;
+    updateMonoChain(chain, settings, thumbnailSampleRate);
+
+    ChainResponse response;
+    captureResponse(chain, thumbnailSampleRate, response);
+
+    MagnitudeGrid grid;
+    std::vector<double> power;
+    computeResponseCurve(response, static_cast<size_t>(numThumbnailPoints), grid, power, thumbnail);
+
+    return true;
+}
+
+//==============================================================================
+PresetBrowserComponent::PresetBrowserComponent(RuckusEQAudioProcessor& p) : audioProcessor(p)
+{
+    list.setModel(this);
+    list.setRowHeight(44);
+    list.setColour(juce::ListBox::backgroundColourId, juce::Colours::black);
+
+    statusLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+
+    addAndMakeVisible(statusLabel);
+    addAndMakeVisible(list);
+
+    thumbnails->addChangeListener(this);
+}
+
+PresetBrowserComponent::~PresetBrowserComponent()
+{
+    thumbnails->removeChangeListener(this);
+    list.setModel(nullptr);
+}
+
+//every time the browser is shown the directory is listed again in the background, the previous list stays up until that's done. hidden browsers don't keep the pool busy.
+void PresetBrowserComponent::visibilityChanged()
+{
+    if (! isVisible())
+    {
+        thumbnails->cancelPendingWork();
+        return;
+    }
+
+    if (presets.isEmpty())
+        statusLabel.setText("Scanning " + directory.getFullPathName(), juce::dontSendNotification);
+
+    juce::Component::SafePointer<PresetBrowserComponent> safeThis(this);
+
+    thumbnails->scan(directory, [safeThis](juce::Array<PresetInfo> scanned)
+    {
+        if (auto* browser = safeThis.getComponent())
+        {
+            browser->presets = std::move(scanned);
+            browser->statusLabel.setText(juce::String(browser->presets.size()) + " presets in " + browser->directory.getFullPathName(), juce::dontSendNotification);
+            browser->list.updateContent();
+            browser->list.repaint();
+        }
+    });
+}
+
+void PresetBrowserComponent::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::black);
+
+    g.setColour(juce::Colours::orange);
+    g.drawRoundedRectangle(getLocalBounds().toFloat(), 4.f, 1.f);
+}
+
+void PresetBrowserComponent::resized()
+{
+    auto bounds = getLocalBounds().reduced(4);
+
+    statusLabel.setBounds(bounds.removeFromTop(20));
+    list.setBounds(bounds);
+}
+
+int PresetBrowserComponent::getNumRows()
+{
+    return presets.size();
+}
+
+//a thumbnail on the left, drawn like the response curve on the same -24 to +24 dB scale, and the preset name beside it.
+void PresetBrowserComponent::paintListBoxItem(int row, juce::Graphics& g, int width, int height, bool rowIsSelected)
+{
+    using namespace juce;
+
+    if (! isPositiveAndBelow(row, presets.size()))
+        return;
+
+    const auto& preset = presets.getReference(row);
+
+    if (rowIsSelected)
+        g.fillAll(Colours::darkgrey);
+
+    auto bounds = Rectangle<int>(width, height).reduced(2);
+    auto thumbnailArea = bounds.removeFromLeft(height * 5 / 2).toFloat();
+
+    g.setColour(Colours::orange);
+    g.drawRoundedRectangle(thumbnailArea, 3.f, 1.f);
+
+    //painting is what asks for a thumbnail, so only rows that are on screen are ever queued.
+    if (auto* thumbnail = thumbnails->getThumbnail(preset))
+    {
+        if (thumbnail->empty())
+        {
+            g.setColour(Colours::grey);
+            g.drawText("?", thumbnailArea, Justification::centred);
+        }
+        else
+        {
+            auto area = thumbnailArea.reduced(2.f);
+            const auto numPoints = static_cast<int>(thumbnail->size());
+
+            auto map = [&area](float decibels)
+            {
+                return jmap(jlimit(-24.f, 24.f, decibels), -24.f, 24.f, area.getBottom(), area.getY());
+            };
+
+            Path curve;
+            curve.startNewSubPath(area.getX(), map(thumbnail->front()));
+
+            for (int i = 1; i < numPoints; ++i)
+                curve.lineTo(area.getX() + area.getWidth() * static_cast<float>(i) / static_cast<float>(numPoints - 1), map((*thumbnail)[static_cast<size_t>(i)]));
+
+            g.setColour(Colours::white);
+            g.strokePath(curve, PathStrokeType(1.f));
+        }
+    }
+
+    g.setColour(Colours::white);
+    g.setFont(14.f);
+    g.drawText(preset.file.getFileNameWithoutExtension(), bounds.withTrimmedLeft(8), Justification::centredLeft, true);
+}
+
+void PresetBrowserComponent::listBoxItemDoubleClicked(int row, const juce::MouseEvent&)
+{
+    loadPreset(row);
+}
+
+void PresetBrowserComponent::returnKeyPressed(int lastRowSelected)
+{
+    loadPreset(lastRowSelected);
+}
+
+void PresetBrowserComponent::changeListenerCallback(juce::ChangeBroadcaster*)
+{
+    list.repaint();
+}
+
+//presets are small, reading one here is a single short read. the processor picks the state up at the start of its next block.
+void PresetBrowserComponent::loadPreset(int row)
+{
+    if (! juce::isPositiveAndBelow(row, presets.size()))
+        return;
+
+    juce::MemoryBlock state;
+
+    if (presets.getReference(row).file.loadFileAsData(state))
+        audioProcessor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    PresetBrowser.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//a preset file as the browser lists it. the modification time is taken when the directory is scanned, so an edited preset gets a new thumbnail without the message thread touching the file system.
+struct PresetInfo
+{
+    juce::File file;
+    juce::Time modified;
+};
+
+//response curve thumbnails of preset files, which hold a state blob exactly as getStateInformation writes it.
+//thumbnails are designed on a background pool with the same design and curve functions the editor draws with, then kept in memory and on disk. the disk cache is keyed by a hash of the preset's content, so renamed or copied presets hit it and edited ones miss it.
+//nothing the message thread calls waits for a thumbnail. finished ones come back through MessageManager::callAsync and listeners get a change message.
+//one cache is shared by every open browser through juce::SharedResourcePointer.
+class PresetThumbnailCache : public juce::ChangeBroadcaster
+{
+public:
+    //dB values at this many points of the editor's frequency axis, designed at a fixed rate so a cached thumbnail doesn't depend on the session it was made in.
+    static constexpr int numThumbnailPoints = 128;
+    static constexpr double thumbnailSampleRate = 48000.0;
+
+    using Thumbnail = std::vector<float>;
+
+    static constexpr const char* presetFileExtension = ".ruckuspreset";
+
+    PresetThumbnailCache();
+    ~PresetThumbnailCache() override;
+
+    static juce::File getDefaultPresetDirectory();
+
+    //lists the presets under a directory, subdirectories included, sorted by name. runs on the pool, onScanned is called on the message thread.
+    void scan(const juce::File& directory, std::function<void(juce::Array<PresetInfo>)> onScanned);
+
+    //message thread. the thumbnail if it's ready, otherwise nullptr and it's queued. an empty thumbnail means the file couldn't be read as a preset.
+    const Thumbnail* getThumbnail(const PresetInfo& preset);
+
+    //drops queued work that hasn't started yet, e.g. when a browser is hidden. it's queued again the next time it's asked for.
+    void cancelPendingWork();
+
+    //any thread. designs the main eq of one state blob and evaluates its curve. returns false if the blob isn't a saved state.
+    static bool computeThumbnail(const juce::MemoryBlock& state, Thumbnail& thumbnail);
+
+private:
+    juce::File cacheDirectory;
+
+    struct Entry
+    {
+        juce::Time modified;
+        Thumbnail thumbnail;
+        bool isReady { false };
+    };
+
+    //message thread only, keyed by full path.
+    std::map<juce::String, Entry> entries;
+
+    void thumbnailArrived(const juce::String& path, juce::Time modified, Thumbnail thumbnail);
+
+    //last, so it's stopped before anything its jobs could touch goes away.
+    juce::ThreadPool pool;
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (PresetThumbnailCache)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetThumbnailCache)
+};
+
+//lists the presets in the preset directory with a thumbnail of each one's response curve. rows only ask for their thumbnail when they're painted, so opening the browser costs a directory listing however many presets there are.
+//double click or return loads a preset into the processor.
+class PresetBrowserComponent : public juce::Component,
+private juce::ListBoxModel,
+private juce::ChangeListener
+{
+public:
+    explicit PresetBrowserComponent(RuckusEQAudioProcessor&);
+    ~PresetBrowserComponent() override;
+
+    void visibilityChanged() override;
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+private:
+    int getNumRows() override;
+    void paintListBoxItem(int row, juce::Graphics& g, int width, int height, bool rowIsSelected) override;
+    void listBoxItemDoubleClicked(int row, const juce::MouseEvent&) override;
+    void returnKeyPressed(int lastRowSelected) override;
+
+    //a thumbnail arrived, the rows showing pick it up when they repaint.
+    void changeListenerCallback(juce::ChangeBroadcaster*) override;
+
+    void loadPreset(int row);
+
+    RuckusEQAudioProcessor& audioProcessor;
+    juce::SharedResourcePointer<PresetThumbnailCache> thumbnails;
+
+    juce::File directory { PresetThumbnailCache::getDefaultPresetDirectory() };
+    juce::Array<PresetInfo> presets;
+
+    juce::Label statusLabel;
+    juce::ListBox list;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetBrowserComponent)
+};
@@ -0,0 +1,404 @@
+/*
+  ==============================================================================
+
+    ReferenceFilters.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "ReferenceFilters.h"
+
+namespace Reference
+{
+    Biquad makePeak(double sampleRate, double freq, double quality, double gainInDecibels)
+    {
+        auto A = std::pow(10.0, gainInDecibels / 40.0);
+        auto w0 = juce::MathConstants<double>::twoPi * freq / sampleRate;
+        auto alpha = std::sin(w0) / (2.0 * quality);
+        auto cosW0 = std::cos(w0);
+        auto a0 = 1.0 + alpha / A;
+
+        return { (1.0 + alpha * A) / a0, -2.0 * cosW0 / a0, (1.0 - alpha * A) / a0, -2.0 * cosW0 / a0, (1.0 - alpha / A) / a0 };
+    }
+
+    Biquad makeHighPass(double sampleRate, double freq, double quality)
+    {
+        auto w0 = juce::MathConstants<double>::twoPi * freq / sampleRate;
+        auto alpha = std::sin(w0) / (2.0 * quality);
+        auto cosW0 = std::cos(w0);
+        auto a0 = 1.0 + alpha;
+
+        return { (1.0 + cosW0) / (2.0 * a0), -(1.0 + cosW0) / a0, (1.0 + cosW0) / (2.0 * a0), -2.0 * cosW0 / a0, (1.0 - alpha) / a0 };
+    }
+
+    Biquad makeLowPass(double sampleRate, double freq, double quality)
+    {
+        auto w0 = juce::MathConstants<double>::twoPi * freq / sampleRate;
+        auto alpha = std::sin(w0) / (2.0 * quality);
+        auto cosW0 = std::cos(w0);
+        auto a0 = 1.0 + alpha;
+
+        return { (1.0 - cosW0) / (2.0 * a0), (1.0 - cosW0) / a0, (1.0 - cosW0) / (2.0 * a0), -2.0 * cosW0 / a0, (1.0 - alpha) / a0 };
+    }
+
+    //q of each section of an even order butterworth filter comes from the angle of its pole pair.
+    static double getButterworthQuality(int order, int section)
+    {
+        return 1.0 / (2.0 * std::cos((2.0 * section + 1.0) * juce::MathConstants<double>::pi / (2.0 * order)));
+    }
+
+    Cascade makeButterworthHighPass(double sampleRate, double freq, Slope slope)
+    {
+        auto order = 2 * (slope + 1);
+        Cascade cascade;
+
+        for (int i = 0; i < order / 2; i++)
+            cascade.push_back(makeHighPass(sampleRate, freq, getButterworthQuality(order, i)));
+
+        return cascade;
+    }
+
+    Cascade makeButterworthLowPass(double sampleRate, double freq, Slope slope)
+    {
+        auto order = 2 * (slope + 1);
+        Cascade cascade;
+
+        for (int i = 0; i < order / 2; i++)
+            cascade.push_back(makeLowPass(sampleRate, freq, getButterworthQuality(order, i)));
+
+        return cascade;
+    }
+
+    double getMagnitudeForFrequency(const Cascade& cascade, double freq, double sampleRate)
+    {
+        auto z = std::polar(1.0, -juce::MathConstants<double>::twoPi * freq / sampleRate);
+        std::complex<double> response { 1.0 };
+
+        for (auto& section : cascade)
+            response *= (section.b0 + section.b1 * z + section.b2 * z * z) / (1.0 + section.a1 * z + section.a2 * z * z);
+
+        return std::abs(response);
+    }
+
+    void process(const Cascade& cascade, std::vector<double>& samples)
+    {
+        for (auto& section : cascade)
+        {
+            double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+            for (auto& sample : samples)
+            {
+                auto x0 = sample;
+                auto y0 = section.b0 * x0 + section.b1 * x1 + section.b2 * x2 - section.a1 * y1 - section.a2 * y2;
+
+                x2 = x1; x1 = x0;
+                y2 = y1; y1 = y0;
+                sample = y0;
+            }
+        }
+    }
+}
+
+AccuracyTolerance getAccuracyTolerance(FilterTopology topology)
+{
+    if (topology == FilterTopology::Topology_Svf)
+        return { 0.01, -80.0, 0.01, -80.0 };
+
+    return { 0.1, -45.0, 12.0, -25.0 };
+}
+
+AccuracyTolerance getFastDesignTolerance(FilterTopology topology)
+{
+    if (topology == FilterTopology::Topology_Svf)
+        return { 0.0001, -80.0, 0.0001, -80.0 };
+
+    return { 0.05, -45.0, 0.05, -45.0 };
+}
+
+bool AccuracyReport::passes(const AccuracyTolerance& tolerance) const
+{
+    return numCases > 0
+        && worst.magnitudeErrorDb <= tolerance.maxMagnitudeErrorDb
+        && worst.renderErrorDb <= tolerance.maxRenderErrorDb
+        && worstLowFrequency.magnitudeErrorDb <= tolerance.maxLowFrequencyMagnitudeErrorDb
+        && worstLowFrequency.renderErrorDb <= tolerance.maxLowFrequencyRenderErrorDb;
+}
+
+juce::String AccuracyReport::toString() const
+{
+    auto describe = [](const Worst& w)
+    {
+        juce::String text;
+        text << w.numCases << " cases, worst magnitude error " << w.magnitudeErrorDb << " dB (" << w.magnitudeCase << ")"
+             << ", worst render error " << w.renderErrorDb << " dB (" << w.renderCase << ")";
+        return text;
+    };
+
+    return describe(worst) + "; below " + juce::String(lowFrequencyRatio) + " of the sample rate " + describe(worstLowFrequency);
+}
+
+//==============================================================================
+namespace
+{
+    constexpr double sampleRates[] { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+    constexpr int renderLength = 4096;
+    constexpr int numProbeFrequencies = 128;
+    
+    //deep in a cut filter's stopband both paths are just rounding noise, so the magnitude is only compared above this level.
+    constexpr double magnitudeFloorDb = -60.0;
+
+    //evenly spaced points across a parameter's range in normalised (skewed) space, endpoints included.
+    std::vector<float> sweep(const juce::NormalisableRange<float>& range, int numPoints)
+    {
+        std::vector<float> points;
+
+        for (int i = 0; i < numPoints; i++)
+            points.push_back(range.convertFrom0to1(static_cast<float>(i) / static_cast<float>(numPoints - 1)));
+
+        return points;
+    }
+
+    const juce::NormalisableRange<float>& getRange(juce::AudioProcessorValueTreeState& apvts, const juce::String& parameterID)
+    {
+        auto* parameter = apvts.getParameter(parameterID);
+        jassert(parameter != nullptr);
+        return parameter->getNormalisableRange();
+    }
+
+    double getStageMagnitude(const Filter& stage, double freq, double sampleRate)
+    {
+        return stage.coefficients->getMagnitudeForFrequency(freq, sampleRate);
+    }
+
+    double getStageMagnitude(const SvfFilter& stage, double freq, double sampleRate)
+    {
+        return getMagnitudeForFrequency(stage.coefficients, freq, sampleRate);
+    }
+
+    template <typename CutType>
+    double getCutMagnitude(const CutType& cut, double freq, double sampleRate)
+    {
+        double mag = 1.0;
+
+        if (! cut.template isBypassed<0>()) mag *= getStageMagnitude(cut.template get<0>(), freq, sampleRate);
+        if (! cut.template isBypassed<1>()) mag *= getStageMagnitude(cut.template get<1>(), freq, sampleRate);
+        if (! cut.template isBypassed<2>()) mag *= getStageMagnitude(cut.template get<2>(), freq, sampleRate);
+        if (! cut.template isBypassed<3>()) mag *= getStageMagnitude(cut.template get<3>(), freq, sampleRate);
+
+        return mag;
+    }
+
+    //magnitude of everything that isn't bypassed, evaluated from the coefficients the chain actually runs with.
+    template <typename ChainType>
+    double getChainMagnitude(const ChainType& chain, double freq, double sampleRate)
+    {
+        double mag = 1.0;
+
+        if (! chain.template isBypassed<ChainPositions::highPass>())
+            mag *= getCutMagnitude(chain.template get<ChainPositions::highPass>(), freq, sampleRate);
+
+        forEachPeakFilter(chain, [&](size_t band, const auto& stage)
+        {
+            if (! isPeakBypassed(chain, band))
+                mag *= getStageMagnitude(stage, freq, sampleRate);
+        });
+
+        if (! chain.template isBypassed<ChainPositions::lowPass>())
+            mag *= getCutMagnitude(chain.template get<ChainPositions::lowPass>(), freq, sampleRate);
+
+        return mag;
+    }
+
+    //designs the settings into the chain. the settings are expected to be flat everywhere except the stage under test, the cut filters are bypassed unless they are the stage under test.
+    template <typename ChainType>
+    void designCase(ChainType& chain, const ChainSettings& settings, bool testHighPass, bool testLowPass, double sampleRate)
+    {
+        updateMonoChain(chain, settings, sampleRate);
+        chain.template setBypassed<ChainPositions::highPass>(! testHighPass);
+        chain.template setBypassed<ChainPositions::lowPass>(! testLowPass);
+    }
+
+    template <typename ChainType>
+    std::vector<double> renderImpulse(ChainType& chain)
+    {
+        juce::AudioBuffer<float> buffer(1, renderLength);
+        buffer.clear();
+        buffer.setSample(0, 0, 1.f);
+
+        chain.reset();
+        juce::dsp::AudioBlock<float> block(buffer);
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        chain.process(context);
+
+        auto* rendered = buffer.getReadPointer(0);
+        return std::vector<double>(rendered, rendered + renderLength);
+    }
+
+    //compares a designed chain and its impulse response against the expected ones and keeps the worst of each in the report, in the group its tuning frequency falls in.
+    template <typename ChainType, typename ExpectedMagnitude>
+    void compareCase(const ChainType& chain, ExpectedMagnitude&& getExpectedMagnitude, const std::vector<double>& rendered, const std::vector<double>& expected,
+                     double sampleRate, double tuningFreq, const juce::String& description, AccuracyReport& report)
+    {
+        auto& worst = tuningFreq < lowFrequencyRatio * sampleRate ? report.worstLowFrequency : report.worst;
+
+        //frequency response, log spaced over the audible range like the response curve.
+        auto maxProbe = juce::jmin(20000.0, sampleRate * 0.49);
+
+        for (int i = 0; i < numProbeFrequencies; i++)
+        {
+            auto freq = juce::mapToLog10(static_cast<double>(i) / (numProbeFrequencies - 1), 20.0, maxProbe);
+            auto expectedMagnitude = getExpectedMagnitude(freq);
+
+            if (juce::Decibels::gainToDecibels(expectedMagnitude, -300.0) < magnitudeFloorDb)
+                continue;
+
+            auto error = std::abs(juce::Decibels::gainToDecibels(getChainMagnitude(chain, freq, sampleRate) / expectedMagnitude, -300.0));
+
+            if (error > worst.magnitudeErrorDb)
+            {
+                worst.magnitudeErrorDb = error;
+                worst.magnitudeCase = description + ", probe " + juce::String(freq, 1) + " Hz";
+            }
+        }
+
+        double errorEnergy = 0, referenceEnergy = 0;
+
+        for (int i = 0; i < renderLength; i++)
+        {
+            auto difference = rendered[i] - expected[i];
+            errorEnergy += difference * difference;
+            referenceEnergy += expected[i] * expected[i];
+        }
+
+        auto renderError = 10.0 * std::log10(juce::jmax(errorEnergy, 1.0e-30) / juce::jmax(referenceEnergy, 1.0e-30));
+
+        if (renderError > worst.renderErrorDb)
+        {
+            worst.renderErrorDb = renderError;
+            worst.renderCase = description;
+        }
+
+        worst.numCases++;
+        report.numCases++;
+    }
+
+    //with compareWithExactDesign the chain is held against the same chain type designed with the exact design instead of the double precision cascades.
+    template <typename ChainType>
+    AccuracyReport measureChain(juce::AudioProcessorValueTreeState& apvts, CoefficientDesign design, bool compareWithExactDesign)
+    {
+        AccuracyReport report;
+        ChainType chain, exactChain;
+
+        //flat starting point, every peak band at 0 dB is exactly unity so only the stage under test shapes the response.
+        auto flatSettings = getChainSettings(apvts);
+        flatSettings.design = design;
+        for (auto& peak : flatSettings.peaks)
+        {
+            peak.gainInDecibels = 0.f;
+            peak.isOn = true;
+        }
+
+        for (auto sampleRate : sampleRates)
+        {
+            juce::dsp::ProcessSpec spec;
+            spec.maximumBlockSize = renderLength;
+            spec.numChannels = 1;
+            spec.sampleRate = sampleRate;
+            chain.prepare(spec);
+            exactChain.prepare(spec);
+
+            auto measureCase = [&](const ChainSettings& settings, bool testHighPass, bool testLowPass, double tuningFreq, const Reference::Cascade& reference, const juce::String& description)
+            {
+                designCase(chain, settings, testHighPass, testLowPass, sampleRate);
+                auto rendered = renderImpulse(chain);
+
+                if (compareWithExactDesign)
+                {
+                    auto exactSettings = settings;
+                    exactSettings.design = CoefficientDesign::Design_Exact;
+                    designCase(exactChain, exactSettings, testHighPass, testLowPass, sampleRate);
+
+                    compareCase(chain, [&](double freq) { return getChainMagnitude(exactChain, freq, sampleRate); },
+                                rendered, renderImpulse(exactChain), sampleRate, tuningFreq, description, report);
+                    return;
+                }
+
+                std::vector<double> expected(renderLength, 0.0);
+                expected[0] = 1.0;
+                Reference::process(reference, expected);
+
+                compareCase(chain, [&](double freq) { return Reference::getMagnitudeForFrequency(reference, freq, sampleRate); },
+                            rendered, expected, sampleRate, tuningFreq, description, report);
+            };
+
+            for (size_t band = 0; band < numPeakBands; ++band)
+            {
+                juce::String name (peakBands[band].name);
+
+                for (auto freq : sweep(getRange(apvts, name + " Freq"), 7))
+                    for (auto gain : sweep(getRange(apvts, name + " Gain"), 5))
+                        for (auto quality : sweep(getRange(apvts, name + " Q"), 4))
+                        {
+                            auto settings = flatSettings;
+                            settings.peaks[band].freq = freq;
+                            settings.peaks[band].gainInDecibels = gain;
+                            settings.peaks[band].quality = quality;
+
+                            juce::String description;
+                            description << name << " " << freq << " Hz, " << gain << " dB, Q " << quality << " @ " << sampleRate << " Hz";
+
+                            measureCase(settings, false, false, freq, { Reference::makePeak(sampleRate, freq, quality, gain) }, description);
+                        }
+            }
+
+            auto numSlopes = static_cast<int>(getRange(apvts, "HighPass Slope").end) + 1;
+
+            for (int slope = 0; slope < numSlopes; slope++)
+            {
+                for (auto freq : sweep(getRange(apvts, "HighPass Freq"), 7))
+                {
+                    auto settings = flatSettings;
+                    settings.highPassFreq = freq;
+                    settings.highPassSlope = static_cast<Slope>(slope);
+
+                    juce::String description;
+                    description << "HighPass " << freq << " Hz, " << (12 + slope * 12) << " dB/Oct @ " << sampleRate << " Hz";
+
+                    measureCase(settings, true, false, freq, Reference::makeButterworthHighPass(sampleRate, freq, settings.highPassSlope), description);
+                }
+
+                for (auto freq : sweep(getRange(apvts, "LowPass Freq"), 7))
+                {
+                    auto settings = flatSettings;
+                    settings.lowPassFreq = freq;
+                    settings.lowPassSlope = static_cast<Slope>(slope);
+
+                    juce::String description;
+                    description << "LowPass " << freq << " Hz, " << (12 + slope * 12) << " dB/Oct @ " << sampleRate << " Hz";
+
+                    measureCase(settings, false, true, freq, Reference::makeButterworthLowPass(sampleRate, freq, settings.lowPassSlope), description);
+                }
+            }
+        }
+
+        return report;
+    }
+}
+
+AccuracyReport measureAccuracy(juce::AudioProcessorValueTreeState& apvts, FilterTopology topology, CoefficientDesign design)
+{
+    if (topology == FilterTopology::Topology_Svf)
+        return measureChain<SvfMonoChain>(apvts, design, false);
+
+    return measureChain<MonoChain>(apvts, design, false);
+}
+
+AccuracyReport measureFastDesignAccuracy(juce::AudioProcessorValueTreeState& apvts, FilterTopology topology)
+{
+    if (topology == FilterTopology::Topology_Svf)
+        return measureChain<SvfMonoChain>(apvts, CoefficientDesign::Design_Fast, true);
+
+    return measureChain<MonoChain>(apvts, CoefficientDesign::Design_Fast, true);
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    ReferenceFilters.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//double precision reference implementations of the designs the plugin uses, written straight from the rbj cookbook and the butterworth pole angles instead of going through juce's FilterDesign. anything that speeds up the filter path gets checked against these.
+//only the test runner (Tests/RuckusEQTests.jucer) builds this, the plugin itself doesn't.
+namespace Reference
+{
+    //second order section normalised so a0 = 1.
+    struct Biquad
+    {
+        double b0 { 1.0 }, b1 { 0.0 }, b2 { 0.0 }, a1 { 0.0 }, a2 { 0.0 };
+    };
+
+    using Cascade = std::vector<Biquad>;
+
+    Biquad makePeak(double sampleRate, double freq, double quality, double gainInDecibels);
+    Biquad makeHighPass(double sampleRate, double freq, double quality);
+    Biquad makeLowPass(double sampleRate, double freq, double quality);
+
+    //same section order as makeHighPassFilter/makeLowPassFilter, one section per 12 dB/Oct.
+    Cascade makeButterworthHighPass(double sampleRate, double freq, Slope slope);
+    Cascade makeButterworthLowPass(double sampleRate, double freq, Slope slope);
+
+    double getMagnitudeForFrequency(const Cascade& cascade, double freq, double sampleRate);
+
+    //runs the cascade over the samples in place, direct form I in double.
+    void process(const Cascade& cascade, std::vector<double>& samples);
+}
+
+//cases tuned below this fraction of the sample rate (96 Hz at 48 kHz, 384 Hz at 192 kHz) are reported and bounded on their own. that's where a float direct form biquad loses most of its precision to coefficient rounding.
+constexpr double lowFrequencyRatio = 0.002;
+
+//maximum deviation from the reference a filter path may show before it is considered broken.
+//magnitude errors are only compared where the reference response is above -60 dB, the render error is the energy of the difference between the impulse responses relative to the reference.
+struct AccuracyTolerance
+{
+    double maxMagnitudeErrorDb { 0.01 };
+    double maxRenderErrorDb { -80.0 };
+
+    //the same for the cases below lowFrequencyRatio.
+    double maxLowFrequencyMagnitudeErrorDb { 0.01 };
+    double maxLowFrequencyRenderErrorDb { -80.0 };
+};
+
+//the biquad is held to 0.1 dB and -45 dB, measured worst cases are 0.046 dB (a +24 dB, Q 3.4 low band at 88.2 kHz) and -53 dB (the air band at nyquist). below lowFrequencyRatio the float design can't do better than a few dB (a 20 Hz, Q 3.4 rumble cut at 192 kHz misses its gain by several dB), so there it only guards against getting worse than that. the svf has no such problem and is held to the tight bound everywhere.
+AccuracyTolerance getAccuracyTolerance(FilterTopology topology);
+
+//the fast design against the exact one is a much tighter check: both round to float the same way, so what's left is what the approximations in FastDesign.h add. measured worst cases are 0.033 dB and -50 dB render error for the biquad (resonant peaks near nyquist at 44.1 kHz, where the coefficients are most sensitive) and 0.00005 dB and -89 dB for the svf.
+AccuracyTolerance getFastDesignTolerance(FilterTopology topology);
+
+struct AccuracyReport
+{
+    int numCases { 0 };
+
+    struct Worst
+    {
+        int numCases { 0 };
+
+        double magnitudeErrorDb { 0.0 };
+        juce::String magnitudeCase;
+
+        double renderErrorDb { -std::numeric_limits<double>::infinity() };
+        juce::String renderCase;
+    };
+
+    //the cases at or above lowFrequencyRatio, and the ones below.
+    Worst worst, worstLowFrequency;
+
+    bool passes(const AccuracyTolerance& tolerance) const;
+    juce::String toString() const;
+};
+
+//sweeps every band over the parameter ranges declared in apvts (frequency, gain, Q and slope) at all supported sample rates, and compares the chosen topology's MonoChain, designed with the chosen coefficient design, against the reference designs, both as a frequency response and as a rendered impulse response.
+AccuracyReport measureAccuracy(juce::AudioProcessorValueTreeState& apvts, FilterTopology topology, CoefficientDesign design = CoefficientDesign::Design_Exact);
+
+//the same sweep with the fast design, compared case by case against the same topology designed with the exact design in float rather than against the double precision references.
+AccuracyReport measureFastDesignAccuracy(juce::AudioProcessorValueTreeState& apvts, FilterTopology topology);
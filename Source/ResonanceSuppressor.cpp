@@ -0,0 +1,249 @@
+/*
+  ==============================================================================
+
+    ResonanceSuppressor.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "ResonanceSuppressor.h"
+#include "FastDesign.h"
+
+namespace
+{
+    //frames per hop.
+    constexpr int overlap = 4;
+
+    //sum of four squared periodic hann windows at a quarter frame hop.
+    constexpr float squaredWindowSum = 1.5f;
+
+    constexpr double minFrequency = 50.0, maxFrequency = 20000.0;
+
+    //a sixth of an octave each side of a bin. never narrower than a few bins, so a resonance can't be its own envelope at the low end.
+    constexpr double envelopeWidth = 0.1225;
+    constexpr int minEnvelopeHalfWidth = 3;
+
+    constexpr double attackSeconds = 0.01, releaseSeconds = 0.15;
+}
+
+void ResonanceSuppressor::prepare(double sampleRate, int numChannels)
+{
+    //2048 points at 44.1 and 48 kHz, doubled for each doubling of the rate.
+    fftOrder = 11 + (sampleRate > 50000.0 ? 1 : 0) + (sampleRate > 100000.0 ? 1 : 0);
+    fftSize = 1 << fftOrder;
+    hopSize = fftSize / overlap;
+    numBins = fftSize / 2 + 1;
+
+    fft = std::make_unique<juce::dsp::FFT>(fftOrder);
+
+    analysisWindow.resize(static_cast<size_t>(fftSize));
+    synthesisWindow.resize(static_cast<size_t>(fftSize));
+
+    for (int i = 0; i < fftSize; ++i)
+    {
+        auto w = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * static_cast<float>(i) / static_cast<float>(fftSize));
+        analysisWindow[static_cast<size_t>(i)] = w;
+        synthesisWindow[static_cast<size_t>(i)] = w / squaredWindowSum;
+    }
+
+    auto binWidth = sampleRate / fftSize;
+    firstBin = juce::jmax(1, static_cast<int>(std::ceil(minFrequency / binWidth)));
+    lastBin = juce::jmin(numBins - 2, static_cast<int>(maxFrequency / binWidth));
+
+    envelopeHalfWidths.resize(static_cast<size_t>(numBins));
+
+    for (int bin = 0; bin < numBins; ++bin)
+        envelopeHalfWidths[static_cast<size_t>(bin)] = juce::jmax(minEnvelopeHalfWidth, juce::roundToInt(bin * envelopeWidth));
+
+    auto hopSeconds = hopSize / sampleRate;
+    attack = static_cast<float>(1.0 - std::exp(-hopSeconds / attackSeconds));
+    release = static_cast<float>(1.0 - std::exp(-hopSeconds / releaseSeconds));
+
+    channels.resize(static_cast<size_t>(numChannels));
+
+    for (auto& channel : channels)
+    {
+        channel.input.resize(static_cast<size_t>(fftSize));
+        channel.output.resize(static_cast<size_t>(fftSize));
+
+        //the real-only transforms work on twice the frame length.
+        channel.frame.resize(static_cast<size_t>(2 * fftSize));
+
+        channel.levels.resize(static_cast<size_t>(numBins));
+        channel.levelSums.resize(static_cast<size_t>(numBins + 1));
+        channel.targetReductions.assign(static_cast<size_t>(numBins + 2), 0.f);
+        channel.reductions.resize(static_cast<size_t>(numBins));
+    }
+
+    reset();
+}
+
+void ResonanceSuppressor::reset() noexcept
+{
+    for (auto& channel : channels)
+    {
+        std::fill(channel.input.begin(), channel.input.end(), 0.f);
+        std::fill(channel.output.begin(), channel.output.end(), 0.f);
+        std::fill(channel.reductions.begin(), channel.reductions.end(), 0.f);
+
+        channel.position = 0;
+        channel.samplesUntilFrame = hopSize;
+    }
+}
+
+void ResonanceSuppressor::setParameters(float depthInDecibels, float thresholdInDecibels) noexcept
+{
+    depth = juce::jmax(0.f, depthInDecibels);
+    threshold = juce::jmax(0.f, thresholdInDecibels);
+}
+
+void ResonanceSuppressor::process(int channelIndex, float* samples, int numSamples) noexcept
+{
+    if (! juce::isPositiveAndBelow(channelIndex, static_cast<int>(channels.size())))
+        return;
+
+    auto& channel = channels[static_cast<size_t>(channelIndex)];
+
+    //copy in and out up to the next hop in one go, then run a frame. the output slot read for a sample is cleared for the frame that lands on it a full frame later.
+    for (int start = 0; start < numSamples;)
+    {
+        auto length = juce::jmin(numSamples - start, channel.samplesUntilFrame, fftSize - channel.position);
+        auto* input = channel.input.data() + channel.position;
+        auto* output = channel.output.data() + channel.position;
+
+        for (int i = 0; i < length; ++i)
+        {
+            input[i] = samples[start + i];
+            samples[start + i] = output[i];
+        }
+
+        juce::FloatVectorOperations::clear(output, length);
+
+        start += length;
+        channel.position = (channel.position + length) % fftSize;
+        channel.samplesUntilFrame -= length;
+
+        if (channel.samplesUntilFrame == 0)
+        {
+            processFrame(channel);
+            channel.samplesUntilFrame = hopSize;
+        }
+    }
+}
+
+void ResonanceSuppressor::record(int channelIndex, const float* samples, int numSamples) noexcept
+{
+    if (! juce::isPositiveAndBelow(channelIndex, static_cast<int>(channels.size())))
+        return;
+
+    auto& channel = channels[static_cast<size_t>(channelIndex)];
+
+    //only the last frame is ever read, so a block longer than that just keeps its end.
+    auto skip = juce::jmax(0, numSamples - fftSize);
+    channel.position = (channel.position + skip) % fftSize;
+
+    for (int start = skip; start < numSamples;)
+    {
+        auto length = juce::jmin(numSamples - start, fftSize - channel.position);
+        juce::FloatVectorOperations::copy(channel.input.data() + channel.position, samples + start, length);
+
+        start += length;
+        channel.position = (channel.position + length) % fftSize;
+    }
+}
+
+//the slot a sample is read from k samples from now holds, in the input history, the sample it's the delayed copy of. the frames before now would have left that sample times the sum of their windows there, the frames still to come add the rest, and with no reduction all of them together give the sample back unchanged.
+void ResonanceSuppressor::start() noexcept
+{
+    for (auto& channel : channels)
+    {
+        std::fill(channel.reductions.begin(), channel.reductions.end(), 0.f);
+
+        for (int k = 0; k < fftSize; ++k)
+        {
+            auto weight = 0.f;
+
+            //the earlier frames ended samplesUntilFrame - j hops from now.
+            for (int j = 1; j <= overlap; ++j)
+            {
+                auto index = k - channel.samplesUntilFrame + j * hopSize;
+
+                if (juce::isPositiveAndBelow(index, fftSize))
+                    weight += analysisWindow[static_cast<size_t>(index)] * synthesisWindow[static_cast<size_t>(index)];
+            }
+
+            auto slot = static_cast<size_t>((channel.position + k) % fftSize);
+            channel.output[slot] = channel.input[slot] * weight;
+        }
+    }
+}
+
+void ResonanceSuppressor::processFrame(Channel& channel) noexcept
+{
+    auto* frame = channel.frame.data();
+    auto head = fftSize - channel.position;
+
+    //the oldest input sample sits at position, so the frame is the circular buffer unrolled from there.
+    juce::FloatVectorOperations::multiply(frame, channel.input.data() + channel.position, analysisWindow.data(), head);
+    juce::FloatVectorOperations::multiply(frame + head, channel.input.data(), analysisWindow.data() + head, channel.position);
+
+    fft->performRealOnlyForwardTransform(frame, true);
+
+    auto* levels = channel.levels.data();
+    auto* sums = channel.levelSums.data();
+    auto* targets = channel.targetReductions.data() + 1;
+    auto* reductions = channel.reductions.data();
+
+    //level of every bin in dB. the small offset keeps silence finite. std::log10 is a library call per bin, the branchless approximation lets the loop vectorise.
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        auto re = frame[2 * bin], im = frame[2 * bin + 1];
+        levels[bin] = 10.f * FastDesign::log10(re * re + im * im + 1.0e-20f);
+    }
+
+    //running sum, so every bin's envelope is the mean level of its neighbourhood in two lookups however wide it is.
+    sums[0] = 0.0;
+
+    for (int bin = 0; bin < numBins; ++bin)
+        sums[bin + 1] = sums[bin] + levels[bin];
+
+    //how far each bin pokes out above its envelope beyond the threshold, capped at the depth.
+    std::fill(targets, targets + numBins, 0.f);
+
+    for (int bin = firstBin; bin <= lastBin; ++bin)
+    {
+        auto halfWidth = envelopeHalfWidths[static_cast<size_t>(bin)];
+        auto low = juce::jmax(0, bin - halfWidth), high = juce::jmin(numBins - 1, bin + halfWidth);
+        auto envelope = static_cast<float>((sums[high + 1] - sums[low]) / (high - low + 1));
+
+        targets[bin] = juce::jlimit(0.f, depth, levels[bin] - envelope - threshold);
+    }
+
+    //spread each reduction over its neighbours so a notch never sits on a single bin, which would ring for the whole frame. then follow it over time, attacking fast and releasing slowly, and turn it into a gain. every bin only reads the targets, so this loop vectorises as well.
+    auto* gains = levels;
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        auto target = juce::jmax(targets[bin], 0.5f * juce::jmax(targets[bin - 1], targets[bin + 1]));
+
+        auto reduction = reductions[bin];
+        reduction += (target > reduction ? attack : release) * (target - reduction);
+        reductions[bin] = reduction;
+
+        gains[bin] = FastDesign::exp10(-0.05f * reduction);
+    }
+
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        frame[2 * bin] *= gains[bin];
+        frame[2 * bin + 1] *= gains[bin];
+    }
+
+    fft->performRealOnlyInverseTransform(frame);
+
+    //overlap-add into the output, starting at the slot the next input sample will be read from.
+    juce::FloatVectorOperations::addWithMultiply(channel.output.data() + channel.position, frame, synthesisWindow.data(), head);
+    juce::FloatVectorOperations::addWithMultiply(channel.output.data(), frame + head, synthesisWindow.data() + head, channel.position);
+}
@@ -0,0 +1,78 @@
+/*
+  ==============================================================================
+
+    ResonanceSuppressor.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//adaptive notching of narrow resonances after the eq. a streaming stft finds bins that stick out of the spectral envelope around them and turns them down, smoothed over neighbouring bins and over time, then overlap-adds the result back together.
+//frames are hann windowed on the way in and out with 75% overlap. the frame length grows with the sample rate so the frequency resolution stays about 23 Hz from 44.1 kHz up to 192 kHz, and the output is delayed by one frame. while it's switched off nothing is delayed, record() only keeps the last frame of input so switching on can carry on from real audio.
+//everything is allocated in prepare(), process() only runs the fft and the spectral math on preallocated frames. channels have independent state, so they can be processed on different threads.
+class ResonanceSuppressor
+{
+public:
+    //allocates. the frame length, and so the latency, depends on the sample rate.
+    void prepare(double sampleRate, int numChannels);
+
+    //clears every channel's frames and gains. doesn't allocate.
+    void reset() noexcept;
+
+    //audio thread, when switching on after record(). clears the gains and fills the overlap-add output with what the recorded frame gives at unity gain, so the output goes on as the input delayed by a frame without a gap. doesn't allocate.
+    void start() noexcept;
+
+    //the delay while processing. record() doesn't delay anything.
+    int getLatencyInSamples() const noexcept { return fftSize; }
+
+    //depth is the most a bin is turned down, threshold is how far above its envelope a bin has to be before anything happens, both in dB.
+    void setParameters(float depthInDecibels, float thresholdInDecibels) noexcept;
+
+    //audio thread, in place.
+    void process(int channel, float* samples, int numSamples) noexcept;
+
+    //audio thread. keeps the last frame of input for while the suppressor is off, the samples pass through untouched. call start() before going back to process().
+    void record(int channel, const float* samples, int numSamples) noexcept;
+
+private:
+    int fftOrder { 11 }, fftSize { 1 << 11 }, hopSize { 1 << 9 }, numBins { (1 << 10) + 1 };
+    std::unique_ptr<juce::dsp::FFT> fft;
+
+    //periodic hann for analysis, the synthesis copy also carries the 1 / 1.5 that makes four overlapping squared windows sum to one.
+    std::vector<float> analysisWindow, synthesisWindow;
+
+    //half width in bins of the envelope around each bin, about a sixth of an octave each side.
+    std::vector<int> envelopeHalfWidths;
+
+    //bins outside roughly 50 Hz to 20 kHz are never touched.
+    int firstBin { 1 }, lastBin { 1 };
+
+    float depth { 6.f }, threshold { 9.f };
+
+    //per frame smoothing of the reduction: fast to catch a resonance, slow to let it go so the notches don't flutter.
+    float attack { 1.f }, release { 1.f };
+
+    struct Channel
+    {
+        //the last fftSize input samples and the overlap-add accumulator, both circular and indexed by position.
+        std::vector<float> input, output;
+        int position { 0 }, samplesUntilFrame { 0 };
+
+        //frame scratch: interleaved complex spectrum after the forward transform, real samples after the inverse.
+        std::vector<float> frame;
+
+        //per bin level in dB, its running sum for the envelope, and the smoothed reduction in dB. the targets have a zero bin either side so spreading them needs no edge cases, the levels' storage takes the gains once the targets are known.
+        std::vector<float> levels;
+        std::vector<double> levelSums;
+        std::vector<float> targetReductions, reductions;
+    };
+
+    std::vector<Channel> channels;
+
+    void processFrame(Channel& channel) noexcept;
+};
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    ResponseSnapshot.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//the stages the audio thread is running, as normalised biquad sections (b0, b1, b2, a1, a2) in chain order, together with the sample rate they were designed for. bypassed stages are left out.
+template <size_t MaxStages>
+struct ResponseSnapshot
+{
+    using Section = std::array<float, 5>;
+
+    double sampleRate { 0.0 };
+    size_t numStages { 0 };
+    std::array<Section, MaxStages> stages {};
+
+    void add(const Section& section) noexcept
+    {
+        jassert(numStages < MaxStages);
+        stages[numStages++] = section;
+    }
+
+    bool operator== (const ResponseSnapshot& other) const noexcept
+    {
+        return sampleRate == other.sampleRate && numStages == other.numStages
+            && std::equal(stages.begin(), stages.begin() + numStages, other.stages.begin());
+    }
+
+    bool operator!= (const ResponseSnapshot& other) const noexcept { return ! (*this == other); }
+};
+
+//hands a ResponseSnapshot from the audio thread to the message thread through a seqlock. the writer never waits or allocates, a reader that overlaps a write just copies again.
+//the sequence number is odd while a write is in progress and doubles as a version, so readers can tell whether anything changed without copying.
+//there must only ever be one writer. nothing is sent to readers, publishing runs on the audio thread, they compare the version when they want to know.
+template <size_t MaxStages>
+class PublishedResponse
+{
+public:
+    using Snapshot = ResponseSnapshot<MaxStages>;
+
+    //audio thread. identical snapshots are dropped, so calling this every block only costs a compare.
+    void publish(const Snapshot& snapshot) noexcept
+    {
+        if (snapshot == lastPublished)
+            return;
+
+        lastPublished = snapshot;
+
+        auto sequence = version.load(std::memory_order_relaxed);
+        version.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        sampleRate.store(snapshot.sampleRate, std::memory_order_relaxed);
+        numStages.store(snapshot.numStages, std::memory_order_relaxed);
+
+        for (size_t stage = 0; stage < snapshot.numStages; ++stage)
+            for (size_t i = 0; i < 5; ++i)
+                coefficients[stage * 5 + i].store(snapshot.stages[stage][i], std::memory_order_relaxed);
+
+        version.store(sequence + 2, std::memory_order_release);
+    }
+
+    //any thread. returns the version of the copy, 0 means nothing has been published yet.
+    juce::uint32 read(Snapshot& snapshot) const noexcept
+    {
+        for (;;)
+        {
+            auto before = version.load(std::memory_order_acquire);
+
+            if ((before & 1u) != 0)
+                continue;
+
+            snapshot.sampleRate = sampleRate.load(std::memory_order_relaxed);
+            snapshot.numStages = juce::jmin(numStages.load(std::memory_order_relaxed), MaxStages);
+
+            for (size_t stage = 0; stage < snapshot.numStages; ++stage)
+                for (size_t i = 0; i < 5; ++i)
+                    snapshot.stages[stage][i] = coefficients[stage * 5 + i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (version.load(std::memory_order_relaxed) == before)
+                return before / 2;
+        }
+    }
+
+    juce::uint32 getVersion() const noexcept { return version.load(std::memory_order_acquire) / 2; }
+
+private:
+    std::atomic<juce::uint32> version { 0 };
+    std::atomic<double> sampleRate { 0.0 };
+    std::atomic<size_t> numStages { 0 };
+    std::array<std::atomic<float>, MaxStages * 5> coefficients {};
+
+    //writer side only.
+    Snapshot lastPublished;
+};
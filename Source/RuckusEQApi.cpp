@@ -0,0 +1,290 @@
+/*
+  ==============================================================================
+
+    RuckusEQApi.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "RuckusEQApi.h"
+#include "SegmentRender.h"
+
+struct RuckusEQ
+{
+    double sampleRate { 44100.0 };
+    ChainSettings settings;
+
+    //one chain per channel, sharing the first chain's coefficient objects.
+    juce::OwnedArray<MonoChain> chains;
+};
+
+//same tile lengths as the processor uses for large blocks. interleaved tiles count frames, so a few channels still fit in L1.
+static_assert(maxPeakBands == RUCKUSEQ_MAX_PEAK_BANDS, "RuckusEQSettings must have room for every peak band");
+static_assert(segmentRenderErrorBound == RUCKUSEQ_RENDER_ERROR_BOUND, "the documented render error bound must match the one the render is sized for");
+
+static constexpr int planarTileSize = 4096;
+static constexpr int interleavedTileFrames = 1024;
+
+static ChainSettings toChainSettings(const RuckusEQSettings& s)
+{
+    ChainSettings settings;
+
+    for (size_t band = 0; band < numPeakBands; ++band)
+    {
+        settings.peaks[band].freq = s.peaks[band].freq;
+        settings.peaks[band].gainInDecibels = s.peaks[band].gainInDecibels;
+        settings.peaks[band].quality = s.peaks[band].quality;
+        settings.peaks[band].isOn = s.peaks[band].isOn != 0;
+    }
+
+    settings.highPassFreq = s.highPassFreq;
+    settings.lowPassFreq = s.lowPassFreq;
+    settings.highPassSlope = static_cast<Slope>(juce::jlimit(0, 3, s.highPassSlope));
+    settings.lowPassSlope = static_cast<Slope>(juce::jlimit(0, 3, s.lowPassSlope));
+
+    settings.design = s.design == CoefficientDesign::Design_Fast ? CoefficientDesign::Design_Fast : CoefficientDesign::Design_Exact;
+
+    return settings;
+}
+
+static RuckusEQSettings fromChainSettings(const ChainSettings& settings)
+{
+    //entries past the band table are zeroed and switched off.
+    RuckusEQSettings s {};
+
+    for (size_t band = 0; band < numPeakBands; ++band)
+    {
+        s.peaks[band].freq = settings.peaks[band].freq;
+        s.peaks[band].gainInDecibels = settings.peaks[band].gainInDecibels;
+        s.peaks[band].quality = settings.peaks[band].quality;
+        s.peaks[band].isOn = settings.peaks[band].isOn ? 1 : 0;
+    }
+
+    s.highPassFreq = settings.highPassFreq;
+    s.lowPassFreq = settings.lowPassFreq;
+    s.highPassSlope = settings.highPassSlope;
+    s.lowPassSlope = settings.lowPassSlope;
+
+    s.design = settings.design;
+
+    return s;
+}
+
+//the biquad chain is the only one this interface runs.
+static void applySettings(RuckusEQ& eq, const ChainSettings& settings)
+{
+    eq.settings = settings;
+    eq.settings.topology = FilterTopology::Topology_Biquad;
+
+    //the coefficients are shared, so only the first chain needs designing. the others just follow its bypass flags.
+    auto& first = *eq.chains.getFirst();
+    updateMonoChain(first, eq.settings, eq.sampleRate);
+
+    for (int channel = 1; channel < eq.chains.size(); channel++)
+        copyBypassFlags(first, *eq.chains.getUnchecked(channel));
+}
+
+//calls function for every stage that isn't bypassed, in signal order.
+template <typename Function>
+static void forEachActiveStage(MonoChain& chain, Function&& function)
+{
+    auto& highPass = chain.get<ChainPositions::highPass>();
+    auto& lowPass = chain.get<ChainPositions::lowPass>();
+
+    if (! highPass.isBypassed<0>()) function(highPass.get<0>());
+    if (! highPass.isBypassed<1>()) function(highPass.get<1>());
+    if (! highPass.isBypassed<2>()) function(highPass.get<2>());
+    if (! highPass.isBypassed<3>()) function(highPass.get<3>());
+
+    forEachPeakFilter(chain, [&](size_t band, Filter& filter)
+    {
+        if (! isPeakBypassed(chain, band))
+            function(filter);
+    });
+
+    if (! lowPass.isBypassed<0>()) function(lowPass.get<0>());
+    if (! lowPass.isBypassed<1>()) function(lowPass.get<1>());
+    if (! lowPass.isBypassed<2>()) function(lowPass.get<2>());
+    if (! lowPass.isBypassed<3>()) function(lowPass.get<3>());
+}
+
+//==============================================================================
+int ruckuseq_get_num_peak_bands(void)
+{
+    return static_cast<int>(numPeakBands);
+}
+
+const char* ruckuseq_get_peak_band_name(int band)
+{
+    if (! juce::isPositiveAndBelow(band, static_cast<int>(numPeakBands)))
+        return nullptr;
+
+    return peakBands[band].name;
+}
+
+void ruckuseq_get_default_settings(RuckusEQSettings* settings)
+{
+    if (settings != nullptr)
+        *settings = fromChainSettings(getDefaultChainSettings());
+}
+
+RuckusEQ* ruckuseq_create(double sampleRate, int numChannels, int maximumBlockSize)
+{
+    if (sampleRate <= 0.0 || numChannels <= 0 || maximumBlockSize <= 0)
+        return nullptr;
+
+    auto eq = std::make_unique<RuckusEQ>();
+    eq->sampleRate = sampleRate;
+
+    for (int channel = 0; channel < numChannels; channel++)
+        eq->chains.add(new MonoChain());
+
+    shareCoefficients(eq->chains);
+
+    juce::dsp::ProcessSpec spec;
+    spec.maximumBlockSize = static_cast<juce::uint32>(maximumBlockSize);
+    spec.numChannels = 1;
+    spec.sampleRate = sampleRate;
+
+    for (auto* chain : eq->chains)
+        chain->prepare(spec);
+
+    applySettings(*eq, getDefaultChainSettings());
+
+    return eq.release();
+}
+
+void ruckuseq_destroy(RuckusEQ* eq)
+{
+    delete eq;
+}
+
+RuckusEQStatus ruckuseq_set_settings(RuckusEQ* eq, const RuckusEQSettings* settings)
+{
+    if (eq == nullptr || settings == nullptr)
+        return RUCKUSEQ_INVALID_ARGUMENT;
+
+    applySettings(*eq, toChainSettings(*settings));
+    return RUCKUSEQ_OK;
+}
+
+RuckusEQStatus ruckuseq_get_settings(const RuckusEQ* eq, RuckusEQSettings* settings)
+{
+    if (eq == nullptr || settings == nullptr)
+        return RUCKUSEQ_INVALID_ARGUMENT;
+
+    *settings = fromChainSettings(eq->settings);
+    return RUCKUSEQ_OK;
+}
+
+RuckusEQStatus ruckuseq_load_state(RuckusEQ* eq, const void* data, size_t sizeInBytes)
+{
+    if (eq == nullptr || data == nullptr)
+        return RUCKUSEQ_INVALID_ARGUMENT;
+
+    //getStateInformation writes the apvts state tree: a "Parameters" node with one PARAM child (id, value) per parameter, values in real units.
+    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
+
+    if (! tree.isValid() || ! tree.hasType("Parameters"))
+        return RUCKUSEQ_INVALID_STATE;
+
+    auto settings = eq->settings;
+    auto isMidSide = false;
+
+    for (const auto& child : tree)
+    {
+        if (! (child.hasType("PARAM") && child.hasProperty("id") && child.hasProperty("value")))
+            continue;
+
+        auto id = child["id"].toString();
+        auto value = static_cast<float>(child["value"]);
+
+        //only the main chain is rendered here, so a mid/side state can't be reproduced. the caller is told rather than getting a different sound silently.
+        if (id == "Mid Side")
+            isMidSide = value > 0.5f;
+        else
+            applyChainParameter(settings, id, value);
+    }
+
+    applySettings(*eq, settings);
+    return isMidSide ? RUCKUSEQ_MID_SIDE_IGNORED : RUCKUSEQ_OK;
+}
+
+void ruckuseq_reset(RuckusEQ* eq)
+{
+    if (eq == nullptr)
+        return;
+
+    for (auto* chain : eq->chains)
+        chain->reset();
+}
+
+RuckusEQStatus ruckuseq_process_planar(RuckusEQ* eq, float* const* channels, int numChannels, int numSamples)
+{
+    if (eq == nullptr || channels == nullptr || numChannels < 0 || numChannels > eq->chains.size() || numSamples < 0)
+        return RUCKUSEQ_INVALID_ARGUMENT;
+
+    juce::ScopedNoDenormals noDenormals;
+
+    //wraps the caller's channel pointers directly, the chain processes them in place.
+    juce::dsp::AudioBlock<float> block(channels, static_cast<size_t>(numChannels), static_cast<size_t>(numSamples));
+
+    for (int channel = 0; channel < numChannels; channel++)
+    {
+        auto channelBlock = block.getSingleChannelBlock(static_cast<size_t>(channel));
+
+        for (size_t start = 0; start < channelBlock.getNumSamples(); start += planarTileSize)
+        {
+            auto tile = channelBlock.getSubBlock(start, juce::jmin(static_cast<size_t>(planarTileSize), channelBlock.getNumSamples() - start));
+            juce::dsp::ProcessContextReplacing<float> context(tile);
+            eq->chains.getUnchecked(channel)->process(context);
+        }
+    }
+
+    return RUCKUSEQ_OK;
+}
+
+RuckusEQStatus ruckuseq_process_interleaved(RuckusEQ* eq, float* samples, int numChannels, int numFrames)
+{
+    if (eq == nullptr || samples == nullptr || numChannels < 0 || numChannels > eq->chains.size() || numFrames < 0)
+        return RUCKUSEQ_INVALID_ARGUMENT;
+
+    juce::ScopedNoDenormals noDenormals;
+
+    //the chain's block processing needs contiguous channels, so interleaved audio is run stage by stage with a stride instead of being deinterleaved into a scratch buffer.
+    for (int start = 0; start < numFrames; start += interleavedTileFrames)
+    {
+        auto numTileFrames = juce::jmin(interleavedTileFrames, numFrames - start);
+
+        for (int channel = 0; channel < numChannels; channel++)
+        {
+            auto* first = samples + static_cast<size_t>(start) * static_cast<size_t>(numChannels) + static_cast<size_t>(channel);
+
+            forEachActiveStage(*eq->chains.getUnchecked(channel), [first, numChannels, numTileFrames](Filter& filter)
+            {
+                auto* sample = first;
+
+                for (int frame = 0; frame < numTileFrames; frame++, sample += numChannels)
+                    *sample = filter.processSample(*sample);
+
+                filter.snapToZero();
+            });
+        }
+    }
+
+    return RUCKUSEQ_OK;
+}
+
+RuckusEQStatus ruckuseq_render_planar(RuckusEQ* eq, float* const* channels, int numChannels, long long numSamples)
+{
+    if (eq == nullptr || channels == nullptr || numChannels < 0 || numChannels > eq->chains.size() || numSamples < 0)
+        return RUCKUSEQ_INVALID_ARGUMENT;
+
+    //the render builds its own chains, so the instance's filter state is untouched.
+    juce::SharedResourcePointer<ChannelThreadPool> threads;
+    renderSegmented(eq->settings, eq->sampleRate, channels, numChannels, static_cast<juce::int64>(numSamples), *threads);
+
+    return RUCKUSEQ_OK;
+}
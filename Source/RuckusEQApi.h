@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    RuckusEQApi.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+/*
+    plain C interface to the eq for hosts that want to run it in-process on their own buffers, without the plugin wrapper.
+
+    an instance owns one biquad MonoChain per channel and processes the caller's memory in place, nothing is copied or allocated while processing.
+    instances are independent of each other: any number can run in parallel on different threads, but a single instance must only be used by one thread at a time.
+    the svf topology is a plugin option only, this interface always runs the biquad chain. the coefficient design setting is honoured.
+    mid/side mode is a plugin option only too. every channel runs the plugin's main settings, the side parameter set is never rendered.
+*/
+
+#include <stddef.h>
+
+/* RUCKUSEQ_API marks the functions the shared library exports. Library/RuckusEQShared.jucer defines RUCKUSEQ_BUILDING_SHARED_LIBRARY, callers linking against the windows dll define RUCKUSEQ_SHARED_LIBRARY.
+   builds that compile RuckusEQApi.cpp in directly, the plugin and the static library, need neither. */
+#if defined(RUCKUSEQ_BUILDING_SHARED_LIBRARY)
+ #if defined(_WIN32)
+  #define RUCKUSEQ_API __declspec(dllexport)
+ #else
+  #define RUCKUSEQ_API __attribute__((visibility("default")))
+ #endif
+#elif defined(RUCKUSEQ_SHARED_LIBRARY) && defined(_WIN32)
+ #define RUCKUSEQ_API __declspec(dllimport)
+#else
+ #define RUCKUSEQ_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct RuckusEQ RuckusEQ;
+
+typedef enum RuckusEQStatus
+{
+    RUCKUSEQ_OK = 0,
+    RUCKUSEQ_INVALID_ARGUMENT = -1,  /* null pointer, or a channel/sample count the instance wasn't created for */
+    RUCKUSEQ_INVALID_STATE = -2,     /* state blob that isn't a RuckusEQ getStateInformation block */
+    RUCKUSEQ_MID_SIDE_IGNORED = 1    /* the state was loaded, but it has mid/side mode on. only its main settings were taken, so the output won't match the plugin's */
+} RuckusEQStatus;
+
+/* room for the largest band table the eq can be built with. ruckuseq_get_num_peak_bands() says how many entries are actually used. */
+#define RUCKUSEQ_MAX_PEAK_BANDS 16
+
+typedef struct RuckusEQPeakBand
+{
+    float freq, gainInDecibels, quality;
+    int isOn;  /* bands that are off are skipped entirely */
+} RuckusEQPeakBand;
+
+/* mirrors ChainSettings. frequencies in Hz, gains in dB, slopes 0-3 for 12-48 dB/Oct, design 0 = exact, 1 = fast. */
+typedef struct RuckusEQSettings
+{
+    RuckusEQPeakBand peaks[RUCKUSEQ_MAX_PEAK_BANDS];  /* in signal order, entries past ruckuseq_get_num_peak_bands() are ignored */
+
+    float highPassFreq, lowPassFreq;
+    int highPassSlope, lowPassSlope;
+
+    int design;
+} RuckusEQSettings;
+
+/* the peak bands this build has, and the name each one's parameters are prefixed with in a state block. the name is null for an index out of range. */
+RUCKUSEQ_API int ruckuseq_get_num_peak_bands(void);
+RUCKUSEQ_API const char* ruckuseq_get_peak_band_name(int band);
+
+/* fills settings with the plugin's parameter defaults. */
+RUCKUSEQ_API void ruckuseq_get_default_settings(RuckusEQSettings* settings);
+
+/* allocates an instance for up to numChannels channels, loaded with the default settings. returns null on invalid arguments. */
+RUCKUSEQ_API RuckusEQ* ruckuseq_create(double sampleRate, int numChannels, int maximumBlockSize);
+RUCKUSEQ_API void ruckuseq_destroy(RuckusEQ* eq);
+
+/* designs the coefficients for new settings. the exact design allocates, so call it between blocks rather than on a real-time thread. the fast design (design = 1) never allocates. */
+RUCKUSEQ_API RuckusEQStatus ruckuseq_set_settings(RuckusEQ* eq, const RuckusEQSettings* settings);
+RUCKUSEQ_API RuckusEQStatus ruckuseq_get_settings(const RuckusEQ* eq, RuckusEQSettings* settings);
+
+/* applies a block written by the plugin's getStateInformation. parameters missing from the block keep their current values.
+   a block saved in mid/side mode still loads its main settings, but returns RUCKUSEQ_MID_SIDE_IGNORED instead of RUCKUSEQ_OK. */
+RUCKUSEQ_API RuckusEQStatus ruckuseq_load_state(RuckusEQ* eq, const void* data, size_t sizeInBytes);
+
+/* clears the filter state, e.g. between unrelated files. */
+RUCKUSEQ_API void ruckuseq_reset(RuckusEQ* eq);
+
+/* in place processing. planar takes one pointer per channel, interleaved takes numFrames frames of numChannels samples. */
+RUCKUSEQ_API RuckusEQStatus ruckuseq_process_planar(RuckusEQ* eq, float* const* channels, int numChannels, int numSamples);
+RUCKUSEQ_API RuckusEQStatus ruckuseq_process_interleaved(RuckusEQ* eq, float* samples, int numChannels, int numFrames);
+
+/* largest difference ruckuseq_render_planar allows from the serial render, relative to the peak level of the input. */
+#define RUCKUSEQ_RENDER_ERROR_BOUND 1.0e-7
+
+/* renders a whole stream in place with the instance's settings, split into segments that run on every core. meant for long files rendered offline.
+   the result is what ruckuseq_reset followed by ruckuseq_process_planar over the whole stream would give in exact arithmetic, to within RUCKUSEQ_RENDER_ERROR_BOUND times the input's peak level.
+   both are rendered in float, and their rounding differs after every segment boundary: with low cut sections the two can be around 1e-4 of the peak level apart.
+   the instance's own filter state is left alone. allocates and blocks until the render is done, so never call it on a real-time thread. */
+RUCKUSEQ_API RuckusEQStatus ruckuseq_render_planar(RuckusEQ* eq, float* const* channels, int numChannels, long long numSamples);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+    SegmentRender.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include "SegmentRender.h"
+
+namespace
+{
+    //same tile as the processor uses for large blocks.
+    constexpr int renderTileSize = 4096;
+
+    //every segment renders its warm-up on top of its own samples, keeping segments this many times longer than the warm-up bounds the extra work to an eighth.
+    constexpr juce::int64 segmentToWarmUpRatio = 8;
+
+    //below this the hand-off to the workers costs more than it saves.
+    constexpr juce::int64 minSegmentLength = 1 << 16;
+
+    //a few segments per thread, so the workers that finish early take over the remaining ones.
+    constexpr int segmentsPerThread = 4;
+
+    //the longest warm-up searched for when the caller sets no limit. a chain that still rings after this long, e.g. a resonance right on the unit circle, is rendered serially.
+    constexpr double maxWarmUpSeconds = 60.0;
+
+    //the impulse response is summed in chunks of at least this many samples, or one time constant of the slowest pole if that's longer.
+    constexpr juce::int64 minChunkLength = 1024;
+
+    //radius of the poles of 1 + a1 z^-1 + a2 z^-2, the larger one if they're real.
+    double getPoleRadius(double a1, double a2)
+    {
+        auto discriminant = a1 * a1 - 4.0 * a2;
+
+        if (discriminant < 0.0)
+            return std::sqrt(a2);
+
+        auto root = std::sqrt(discriminant);
+        return juce::jmax(std::abs(-a1 + root), std::abs(-a1 - root)) * 0.5;
+    }
+
+    void processInPlace(MonoChain& chain, float* samples, juce::int64 numSamples)
+    {
+        for (juce::int64 start = 0; start < numSamples; start += renderTileSize)
+        {
+            auto* tileSamples = samples + start;
+            juce::dsp::AudioBlock<float> tile(&tileSamples, 1, static_cast<size_t>(juce::jmin<juce::int64>(renderTileSize, numSamples - start)));
+            juce::dsp::ProcessContextReplacing<float> context(tile);
+            chain.process(context);
+        }
+    }
+}
+
+juce::int64 getWarmUpLength(const ChainResponse& response, double errorBound, juce::int64 maxLength)
+{
+    if (response.numStages == 0)
+        return 0;
+
+    auto slowestRadius = 0.0;
+
+    for (size_t stage = 0; stage < response.numStages; ++stage)
+        slowestRadius = juce::jmax(slowestRadius, getPoleRadius(response.stages[stage][3], response.stages[stage][4]));
+
+    if (slowestRadius >= 1.0 || response.sampleRate <= 0.0)
+        return -1;
+
+    if (maxLength < 0)
+        maxLength = static_cast<juce::int64>(maxWarmUpSeconds * response.sampleRate);
+
+    auto chunkLength = juce::jmax(minChunkLength, static_cast<juce::int64>(std::ceil(1.0 / (1.0 - slowestRadius))));
+
+    //run an impulse through the sections in double precision, transposed direct form II like the juce filters, and keep the magnitude of every output sample.
+    std::vector<double> magnitudes;
+    std::array<std::array<double, 2>, maxChainStages> state {};
+
+    auto previousChunkSum = 0.0, previousRatio = 1.0, remainder = -1.0;
+
+    for (juce::int64 start = 0; start < maxLength && remainder < 0.0; start += chunkLength)
+    {
+        auto chunkSum = 0.0;
+
+        for (juce::int64 i = 0; i < chunkLength; ++i)
+        {
+            auto sample = start + i == 0 ? 1.0 : 0.0;
+
+            for (size_t stage = 0; stage < response.numStages; ++stage)
+            {
+                const auto& c = response.stages[stage];
+                auto& s = state[stage];
+
+                auto output = c[0] * sample + s[0];
+                s[0] = c[1] * sample - c[3] * output + s[1];
+                s[1] = c[2] * sample - c[4] * output;
+                sample = output;
+            }
+
+            magnitudes.push_back(std::abs(sample));
+            chunkSum += std::abs(sample);
+        }
+
+        //once the slowest pole dominates, every chunk shrinks by about the same ratio, repeated poles only make it approach that ratio from above. after two shrinking chunks the rest of the response is bounded by a geometric series in the larger of the two ratios.
+        auto ratio = previousChunkSum > 0.0 ? chunkSum / previousChunkSum : 1.0;
+
+        if (ratio < 1.0 && previousRatio < 1.0)
+        {
+            auto worstRatio = juce::jmax(ratio, previousRatio);
+            auto tail = chunkSum * worstRatio / (1.0 - worstRatio);
+
+            if (tail < errorBound * 0.5)
+                remainder = tail;
+        }
+
+        previousChunkSum = chunkSum;
+        previousRatio = ratio;
+    }
+
+    if (remainder < 0.0)
+        return -1;
+
+    //walk back from the end of the simulated response for as long as what's left over stays within the bound. an input sample that far back can't move the output by more than that.
+    auto length = static_cast<juce::int64>(magnitudes.size());
+
+    while (length > 0 && remainder + magnitudes[static_cast<size_t>(length - 1)] <= errorBound)
+        remainder += magnitudes[static_cast<size_t>(--length)];
+
+    return length <= maxLength ? length : -1;
+}
+
+juce::int64 getWarmUpLength(const ChainSettings& chainSettings, double sampleRate, double errorBound)
+{
+    MonoChain chain;
+    updateMonoChain(chain, chainSettings, sampleRate);
+
+    ChainResponse response;
+    captureResponse(chain, sampleRate, response);
+
+    return getWarmUpLength(response, errorBound);
+}
+
+SegmentPlan planSegments(const ChainResponse& response, int numChannels, juce::int64 numSamples, int numThreads, double errorBound)
+{
+    SegmentPlan plan;
+    plan.segmentLength = numSamples;
+
+    //with one thread, or a stream that can't hold two segments, every segment after the first would only add its warm-up.
+    if (numChannels <= 0 || numThreads <= 1 || numSamples < 2 * minSegmentLength)
+        return plan;
+
+    //a warm-up is only worth it while the segments stay segmentToWarmUpRatio times longer, so there's no point looking further than what still leaves two of them.
+    auto warmUpLength = getWarmUpLength(response, errorBound, numSamples / (2 * segmentToWarmUpRatio));
+
+    if (warmUpLength < 0)
+        return plan;
+
+    //enough segments to keep every thread busy, as long as each one stays long compared to its warm-up.
+    auto wantedSegments = (numThreads * segmentsPerThread + numChannels - 1) / numChannels;
+    auto longestSplit = numSamples / juce::jmax(minSegmentLength, warmUpLength * segmentToWarmUpRatio);
+
+    plan.numSegments = juce::jlimit<juce::int64>(1, wantedSegments, longestSplit);
+    plan.segmentLength = (numSamples + plan.numSegments - 1) / plan.numSegments;
+    plan.warmUpLength = plan.numSegments > 1 ? warmUpLength : 0;
+
+    return plan;
+}
+
+void renderSegmented(const ChainSettings& chainSettings, double sampleRate, float* const* channels, int numChannels, juce::int64 numSamples,
+                     ChannelThreadPool& threads, double errorBound)
+{
+    if (channels == nullptr || numChannels <= 0 || numSamples <= 0 || sampleRate <= 0.0)
+        return;
+
+    //the settings are designed once, into the first chain. the split is planned from what that chain runs.
+    juce::OwnedArray<MonoChain> chains;
+    chains.add(new MonoChain());
+    shareCoefficients(chains);
+    updateMonoChain(*chains.getFirst(), chainSettings, sampleRate);
+
+    ChainResponse response;
+    captureResponse(*chains.getFirst(), sampleRate, response);
+
+    auto plan = planSegments(response, numChannels, numSamples, threads.getNumThreads(), errorBound);
+
+    if (plan.numSegments > 1)
+        threads.startWorkers();
+
+    auto segmentLength = plan.segmentLength;
+    auto warmUpLength = plan.warmUpLength;
+    auto numTasks = static_cast<int>(plan.numSegments) * numChannels;
+
+    //one chain per segment and channel, all running the first chain's coefficient objects.
+    addSharedChains(chains, numTasks);
+
+    juce::dsp::ProcessSpec spec;
+    spec.maximumBlockSize = static_cast<juce::uint32>(renderTileSize);
+    spec.numChannels = 1;
+    spec.sampleRate = sampleRate;
+
+    for (auto* chain : chains)
+        chain->prepare(spec);
+
+    //tasks are numbered segment by segment, the first numChannels tasks are the first segment and start from silence like the serial render.
+    juce::AudioBuffer<float> warmUpTiles(juce::jmax(1, numTasks - numChannels), renderTileSize);
+
+    //every chain runs over the input just before its segment. nothing is written yet, so the input is still unprocessed everywhere.
+    auto warmUp = [&](int task)
+    {
+        if (task < numChannels)
+            return;
+
+        juce::ScopedNoDenormals noDenormals;
+
+        auto* input = channels[task % numChannels] + (task / numChannels) * segmentLength - warmUpLength;
+        auto* tile = warmUpTiles.getWritePointer(task - numChannels);
+
+        for (juce::int64 start = 0; start < warmUpLength; start += renderTileSize)
+        {
+            auto length = juce::jmin<juce::int64>(renderTileSize, warmUpLength - start);
+            std::copy(input + start, input + start + length, tile);
+            processInPlace(*chains.getUnchecked(task), tile, length);
+        }
+    };
+
+    //then every chain renders its own segment in place. segments don't overlap, so the tasks never touch each other's samples.
+    auto render = [&](int task)
+    {
+        juce::ScopedNoDenormals noDenormals;
+
+        auto start = (task / numChannels) * segmentLength;
+        processInPlace(*chains.getUnchecked(task), channels[task % numChannels] + start, juce::jmin(segmentLength, numSamples - start));
+    };
+
+    if (numTasks == 1)
+    {
+        render(0);
+        return;
+    }
+
+    if (plan.numSegments > 1)
+        threads.parallelFor(numTasks, warmUp);
+
+    threads.parallelFor(numTasks, render);
+}
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    SegmentRender.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterChain.h"
+#include "ChannelThreadPool.h"
+
+//offline rendering of one long stream on every core. the filter state only remembers the recent past, so the stream is cut into segments that are rendered independently, each chain first running over the input just before its segment until its state has caught up with what the serial render would hold there.
+
+//largest difference from the serial render allowed by default, relative to the peak level of the input. -140 dB is below the step of 24 bit audio.
+static constexpr double segmentRenderErrorBound = 1.0e-7;
+
+//samples a chain has to run from silence before its output is within errorBound of a chain that has been running since the start of the stream, for any input no louder than 1.
+//this is the point where the sum of the remaining impulse response magnitude drops below errorBound, which bounds the contribution of everything before the warm-up. returns -1 when the chain rings for too long to be worth segmenting.
+//finding the length costs about as much as running that many samples through the chain, so it gives up and returns -1 past maxLength samples. -1 allows a minute of audio.
+juce::int64 getWarmUpLength(const ChainResponse& response, double errorBound = segmentRenderErrorBound, juce::int64 maxLength = -1);
+juce::int64 getWarmUpLength(const ChainSettings& chainSettings, double sampleRate, double errorBound = segmentRenderErrorBound);
+
+//how renderSegmented splits numSamples per channel across numThreads threads. every segment but the first runs warmUpLength samples of the input before it first.
+//a single segment means every channel is rendered serially, on its own thread if there are several channels. that happens when the stream is too short to split, there's only one thread, or the chain rings too long for segments to stay well above their warm-up.
+struct SegmentPlan
+{
+    juce::int64 numSegments { 1 }, segmentLength { 0 }, warmUpLength { 0 };
+};
+
+SegmentPlan planSegments(const ChainResponse& response, int numChannels, juce::int64 numSamples, int numThreads, double errorBound = segmentRenderErrorBound);
+
+//renders numSamples of every channel in place through the biquad chain, as a freshly reset MonoChain per channel would, using every thread of the pool.
+//every output sample is within errorBound times the input's peak level of the serial render, plus the float rounding the chain already has. with low cut sections that rounding is around 1e-4 of the peak level, so errorBound only decides how much warm-up is enough, not how close two float renders come. settings are fixed for the whole stream.
+//allocates the chains and warm-up buffers, so it's for offline use only. the split follows planSegments, the coefficients are designed once and shared by every chain.
+void renderSegmented(const ChainSettings& chainSettings, double sampleRate, float* const* channels, int numChannels, juce::int64 numSamples,
+                     ChannelThreadPool& threads, double errorBound = segmentRenderErrorBound);
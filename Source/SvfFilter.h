@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    SvfFilter.h
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//topology-preserving-transform (TPT) state variable filter. the bilinear transform is applied to each integrator instead of the whole transfer function, so the filter state stays meaningful when the coefficients move. this makes it safe to modulate every sample, unlike the direct form biquad.
+//the peak and butterworth designs below use the same analog prototypes and the same frequency prewarping as juce's makePeakFilter/makeHighPass/makeLowPass, so the magnitude response is identical to the biquad path.
+struct SvfCoefficients
+{
+    //g is the prewarped cutoff tan(pi * f / fs), k is the damping (1 / Q).
+    float g { 0.f }, k { 1.f };
+
+    //mix of the input, bandpass and lowpass outputs that forms the final response.
+    float m0 { 1.f }, m1 { 0.f }, m2 { 0.f };
+
+    bool operator== (const SvfCoefficients& other) const noexcept
+    {
+        return g == other.g && k == other.k && m0 == other.m0 && m1 == other.m1 && m2 == other.m2;
+    }
+
+    bool operator!= (const SvfCoefficients& other) const noexcept { return ! (*this == other); }
+};
+
+//the only transcendental function needed per coefficient change. clamped just below nyquist so tan() stays finite.
+inline float svfPrewarp(float frequency, double sampleRate)
+{
+    auto clamped = juce::jlimit(1.0, sampleRate * 0.499, static_cast<double>(frequency));
+    return static_cast<float>(std::tan(juce::MathConstants<double>::pi * clamped / sampleRate));
+}
+
+//bell filter, equivalent to IIR::Coefficients::makePeakFilter. gainFactor is the linear gain at the centre frequency.
+inline SvfCoefficients makeSvfPeak(double sampleRate, float frequency, float quality, float gainFactor)
+{
+    auto A = std::sqrt(juce::jmax(gainFactor, 1.0e-6f));
+    auto k = 1.f / (quality * A);
+
+    return { svfPrewarp(frequency, sampleRate), k, 1.f, k * (gainFactor - 1.f), 0.f };
+}
+
+inline SvfCoefficients makeSvfHighPass(float g, float k)
+{
+    return { g, k, 1.f, -k, -1.f };
+}
+
+inline SvfCoefficients makeSvfLowPass(float g, float k)
+{
+    return { g, k, 0.f, 0.f, 1.f };
+}
+
+//damping of each second order section of an even order butterworth filter, k = 2cos((2i + 1) * pi / (2 * order)). same section order as FilterDesign::designIIR*HighOrderButterworthMethod, indexed by slope.
+static constexpr float butterworthDamping[4][4]
+{
+    { 1.41421356f, 0.f,         0.f,         0.f         },
+    { 1.84775907f, 0.76536686f, 0.f,         0.f         },
+    { 1.93185165f, 1.41421356f, 0.51763809f, 0.f         },
+    { 1.96157056f, 1.66293922f, 1.11114047f, 0.39018064f }
+};
+
+//one stage of the tpt state variable filter. has the same prepare/reset/process interface as IIR::Filter so it can sit in a ProcessorChain.
+//the public coefficients are the target, when they change the filter ramps towards them sample by sample over the next block instead of jumping. after a reset or a bypassed block it jumps straight to them.
+struct SvfFilter
+{
+    SvfCoefficients coefficients;
+
+    void prepare(const juce::dsp::ProcessSpec&) noexcept { reset(); }
+
+    void reset() noexcept
+    {
+        ic1eq = ic2eq = 0.f;
+        snapToTarget = true;
+    }
+
+    template <typename ProcessContext>
+    void process(const ProcessContext& context) noexcept
+    {
+        auto&& inputBlock = context.getInputBlock();
+        auto&& outputBlock = context.getOutputBlock();
+
+        //this is a mono filter, stereo is handled by running one chain per channel.
+        jassert(inputBlock.getNumChannels() == 1);
+        jassert(outputBlock.getNumChannels() == 1);
+
+        auto numSamples = outputBlock.getNumSamples();
+
+        //current isn't followed while bypassed, so it can be far from the target by the time the stage comes back. ramping from there would sweep through settings that were never heard, so the stage starts on the target instead.
+        if (context.isBypassed)
+        {
+            snapToTarget = true;
+
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(inputBlock);
+
+            return;
+        }
+
+        auto* src = inputBlock.getChannelPointer(0);
+        auto* dst = outputBlock.getChannelPointer(0);
+
+        if (snapToTarget)
+        {
+            current = coefficients;
+            snapToTarget = false;
+        }
+
+        if (current != coefficients && numSamples > 0)
+            processRamped(src, dst, numSamples);
+        else
+            processStatic(src, dst, numSamples);
+
+        juce::dsp::util::snapToZero(ic1eq);
+        juce::dsp::util::snapToZero(ic2eq);
+    }
+
+private:
+    SvfCoefficients current;
+    float ic1eq { 0.f }, ic2eq { 0.f };
+    bool snapToTarget { true };
+
+    inline float tick(float v0, float a1, float a2, float a3, float m0, float m1, float m2) noexcept
+    {
+        auto v3 = v0 - ic2eq;
+        auto v1 = a1 * ic1eq + a2 * v3;
+        auto v2 = ic2eq + a2 * ic1eq + a3 * v3;
+
+        ic1eq = 2.f * v1 - ic1eq;
+        ic2eq = 2.f * v2 - ic2eq;
+
+        return m0 * v0 + m1 * v1 + m2 * v2;
+    }
+
+    void processStatic(const float* src, float* dst, size_t numSamples) noexcept
+    {
+        auto [g, k, m0, m1, m2] = current;
+        auto a1 = 1.f / (1.f + g * (g + k));
+        auto a2 = g * a1;
+        auto a3 = g * a2;
+
+        for (size_t i = 0; i < numSamples; ++i)
+            dst[i] = tick(src[i], a1, a2, a3, m0, m1, m2);
+    }
+
+    //linearly interpolate g, k and the output mix across the block. every intermediate set has g > 0 and k > 0, so the filter stays stable the whole way.
+    void processRamped(const float* src, float* dst, size_t numSamples) noexcept
+    {
+        auto step = 1.f / static_cast<float>(numSamples);
+
+        auto dg = (coefficients.g - current.g) * step;
+        auto dk = (coefficients.k - current.k) * step;
+        auto dm0 = (coefficients.m0 - current.m0) * step;
+        auto dm1 = (coefficients.m1 - current.m1) * step;
+        auto dm2 = (coefficients.m2 - current.m2) * step;
+
+        for (size_t i = 0; i < numSamples; ++i)
+        {
+            current.g += dg;
+            current.k += dk;
+            current.m0 += dm0;
+            current.m1 += dm1;
+            current.m2 += dm2;
+
+            auto a1 = 1.f / (1.f + current.g * (current.g + current.k));
+            auto a2 = current.g * a1;
+            auto a3 = current.g * a2;
+
+            dst[i] = tick(src[i], a1, a2, a3, current.m0, current.m1, current.m2);
+        }
+
+        //land exactly on the target so the next block takes the static path.
+        current = coefficients;
+    }
+};
+
+//magnitude of the digital filter at a given frequency, the svf counterpart of IIR::Coefficients::getMagnitudeForFrequency. substitutes the bilinear mapping s = j * tan(pi * f / fs) / g into the normalised analog prototype.
+inline double getMagnitudeForFrequency(const SvfCoefficients& coefficients, double frequency, double sampleRate)
+{
+    std::complex<double> s (0.0, std::tan(juce::MathConstants<double>::pi * frequency / sampleRate) / coefficients.g);
+    auto denominator = s * s + static_cast<double>(coefficients.k) * s + 1.0;
+    
+    return std::abs((static_cast<double>(coefficients.m0) * denominator + static_cast<double>(coefficients.m1) * s + static_cast<double>(coefficients.m2)) / denominator);
+}
+
+//the direct form biquad with the same transfer function, as normalised (b0, b1, b2, a1, a2). the svf numerator m0 (s^2 + k s + 1) + m1 s + m2 is mapped through s = (1 / g) (1 - z^-1) / (1 + z^-1), the same bilinear transform the svf integrators use.
+inline std::array<float, 5> getBiquadEquivalent(const SvfCoefficients& coefficients)
+{
+    const double g = coefficients.g, k = coefficients.k, m0 = coefficients.m0, m1 = coefficients.m1, m2 = coefficients.m2;
+
+    auto n2 = m0, n1 = m0 * k + m1, n0 = m0 + m2;
+    auto a0 = 1.0 + k * g + g * g;
+
+    return
+    {
+        static_cast<float>((n2 + n1 * g + n0 * g * g) / a0),
+        static_cast<float>((2.0 * n0 * g * g - 2.0 * n2) / a0),
+        static_cast<float>((n2 - n1 * g + n0 * g * g) / a0),
+        static_cast<float>((2.0 * g * g - 2.0) / a0),
+        static_cast<float>((1.0 - k * g + g * g) / a0)
+    };
+}
+
+inline void updateCoefficients(SvfCoefficients& old, const SvfCoefficients& replacements)
+{
+    old = replacements;
+}
+
+//same layout as CutFilter, just built from svf stages. SvfMonoChain is put together next to MonoChain in PluginProcessor.h.
+using SvfCutFilter = juce::dsp::ProcessorChain<SvfFilter, SvfFilter, SvfFilter, SvfFilter>;
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    AccuracyTests.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+#include "../../Source/ReferenceFilters.h"
+
+//both filter topologies over the full parameter ranges of the processor's apvts. the exact design is checked against the double precision reference designs, the fast design against the exact design.
+struct AccuracyTests : juce::UnitTest
+{
+    AccuracyTests() : juce::UnitTest("Filter accuracy", "RuckusEQ") {}
+
+    void runTest() override
+    {
+        RuckusEQAudioProcessor processor;
+
+        for (auto topology : { FilterTopology::Topology_Biquad, FilterTopology::Topology_Svf })
+        {
+            juce::String name (topology == FilterTopology::Topology_Svf ? "svf" : "biquad");
+
+            beginTest(name + ", exact design against the reference");
+            {
+                auto report = measureAccuracy(processor.apvts, topology, CoefficientDesign::Design_Exact);
+                logMessage(report.toString());
+
+                expect(report.passes(getAccuracyTolerance(topology)), report.toString());
+            }
+
+            beginTest(name + ", fast design against the exact design");
+            {
+                auto report = measureFastDesignAccuracy(processor.apvts, topology);
+                logMessage(report.toString());
+
+                expect(report.passes(getFastDesignTolerance(topology)), report.toString());
+            }
+        }
+    }
+};
+
+static AccuracyTests accuracyTests;
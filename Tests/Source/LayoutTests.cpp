@@ -0,0 +1,197 @@
+/*
+  ==============================================================================
+
+    LayoutTests.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+//the bus layouts the processor accepts and what each one does with its channels: every processed channel gets the same eq as a mono instance would apply, mono-to-stereo overwrites whatever the host left in the right output with the processed left, and silent inputs come out silent.
+struct LayoutTests : juce::UnitTest
+{
+    LayoutTests() : juce::UnitTest("Bus layouts", "RuckusEQ") {}
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 512;
+    static constexpr int numBlocks = 16;
+    static constexpr int length = blockSize * numBlocks;
+
+    //what the host leaves in output channels that have no input. anything processBlock doesn't overwrite shows up as this.
+    static constexpr float garbage = 0.5f;
+
+    std::unique_ptr<RuckusEQAudioProcessor> makeProcessor(const juce::AudioChannelSet& input, const juce::AudioChannelSet& output)
+    {
+        auto processor = std::make_unique<RuckusEQAudioProcessor>();
+
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(input);
+        layout.outputBuses.add(output);
+
+        expect(processor->setBusesLayout(layout), "layout " + input.getDescription() + " to " + output.getDescription() + " rejected");
+
+        //a boost that noise can't pass unchanged, so a channel that skipped the eq is told apart from one that went through it.
+        auto* gain = processor->apvts.getParameter("Low Gain");
+        gain->setValueNotifyingHost(gain->convertTo0to1(12.f));
+
+        processor->setRateAndBufferSizeDetails(sampleRate, blockSize);
+        processor->prepareToPlay(sampleRate, blockSize);
+
+        return processor;
+    }
+
+    //runs the input through block by block and returns every output channel. the channels past the inputs start each block filled with garbage.
+    juce::AudioBuffer<float> render(RuckusEQAudioProcessor& processor, const juce::AudioBuffer<float>& input)
+    {
+        auto numInputs = processor.getTotalNumInputChannels();
+        auto numOutputs = processor.getTotalNumOutputChannels();
+
+        juce::AudioBuffer<float> output(numOutputs, length);
+        juce::AudioBuffer<float> buffer(juce::jmax(numInputs, numOutputs), blockSize);
+        juce::MidiBuffer midi;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                if (channel < numInputs)
+                    buffer.copyFrom(channel, 0, input, channel, block * blockSize, blockSize);
+                else
+                    juce::FloatVectorOperations::fill(buffer.getWritePointer(channel), garbage, blockSize);
+            }
+
+            processor.processBlock(buffer, midi);
+
+            for (int channel = 0; channel < numOutputs; ++channel)
+                output.copyFrom(channel, block * blockSize, buffer, channel, 0, blockSize);
+        }
+
+        return output;
+    }
+
+    juce::AudioBuffer<float> makeNoise(int numChannels)
+    {
+        juce::AudioBuffer<float> noise(numChannels, length);
+        auto& random = getRandom();
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < length; ++i)
+                noise.setSample(channel, i, (random.nextFloat() * 2.f - 1.f) * 0.25f);
+
+        return noise;
+    }
+
+    static float getMaxDifference(const juce::AudioBuffer<float>& a, int channelA, const juce::AudioBuffer<float>& b, int channelB)
+    {
+        auto difference = 0.f;
+
+        for (int i = 0; i < length; ++i)
+            difference = juce::jmax(difference, std::abs(a.getSample(channelA, i) - b.getSample(channelB, i)));
+
+        return difference;
+    }
+
+    void expectSilent(const juce::AudioBuffer<float>& buffer, int channel, const juce::String& description)
+    {
+        expectEquals(buffer.getMagnitude(channel, 0, length), 0.f, description);
+    }
+
+    void runTest() override
+    {
+        beginTest("supported layouts");
+        {
+            RuckusEQAudioProcessor processor;
+
+            auto isSupported = [&processor](const juce::AudioChannelSet& input, const juce::AudioChannelSet& output)
+            {
+                juce::AudioProcessor::BusesLayout layout;
+                layout.inputBuses.add(input);
+                layout.outputBuses.add(output);
+                return processor.checkBusesLayoutSupported(layout);
+            };
+
+            expect(isSupported(juce::AudioChannelSet::mono(), juce::AudioChannelSet::mono()));
+            expect(isSupported(juce::AudioChannelSet::mono(), juce::AudioChannelSet::stereo()));
+            expect(isSupported(juce::AudioChannelSet::stereo(), juce::AudioChannelSet::stereo()));
+            expect(isSupported(juce::AudioChannelSet::create5point1(), juce::AudioChannelSet::create5point1()));
+            expect(isSupported(juce::AudioChannelSet::discreteChannels(16), juce::AudioChannelSet::discreteChannels(16)));
+
+            expect(! isSupported(juce::AudioChannelSet::stereo(), juce::AudioChannelSet::mono()));
+            expect(! isSupported(juce::AudioChannelSet::stereo(), juce::AudioChannelSet::create5point1()));
+            expect(! isSupported(juce::AudioChannelSet::stereo(), juce::AudioChannelSet::disabled()));
+        }
+
+        auto noise = makeNoise(16);
+
+        //everything below is compared against this: one channel through a mono instance.
+        beginTest("mono");
+        auto mono = makeProcessor(juce::AudioChannelSet::mono(), juce::AudioChannelSet::mono());
+        auto monoOutput = render(*mono, noise);
+        {
+            auto latency = mono->getLatencySamples();
+            expect(latency < length / 2);
+
+            auto difference = 0.f;
+
+            for (int i = 0; i + latency < length; ++i)
+                difference = juce::jmax(difference, std::abs(monoOutput.getSample(0, i + latency) - noise.getSample(0, i)));
+
+            expectGreaterThan(difference, 0.01f, "the eq left the mono channel unchanged");
+        }
+
+        beginTest("mono to stereo");
+        {
+            auto processor = makeProcessor(juce::AudioChannelSet::mono(), juce::AudioChannelSet::stereo());
+            auto output = render(*processor, noise);
+
+            expectEquals(getMaxDifference(output, 0, monoOutput, 0), 0.f, "left output isn't what a mono instance gives");
+            expectEquals(getMaxDifference(output, 1, output, 0), 0.f, "right output isn't a copy of the processed left");
+        }
+
+        beginTest("stereo");
+        {
+            auto processor = makeProcessor(juce::AudioChannelSet::stereo(), juce::AudioChannelSet::stereo());
+
+            auto input = noise;
+            input.clear(1, 0, length);
+
+            auto output = render(*processor, input);
+
+            expectEquals(getMaxDifference(output, 0, monoOutput, 0), 0.f, "left output isn't what a mono instance gives");
+            expectSilent(output, 1, "right output of a silent input isn't silent");
+        }
+
+        for (auto layout : { juce::AudioChannelSet::create5point1(), juce::AudioChannelSet::discreteChannels(16) })
+        {
+            beginTest(layout.getDescription());
+
+            auto processor = makeProcessor(layout, layout);
+            auto numChannels = layout.size();
+
+            //every other channel carries the same noise as channel 0, the rest are silent.
+            juce::AudioBuffer<float> input(numChannels, length);
+            input.clear();
+
+            for (int channel = 0; channel < numChannels; channel += 2)
+                input.copyFrom(channel, 0, noise, 0, 0, length);
+
+            auto output = render(*processor, input);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                auto description = "channel " + juce::String(channel);
+
+                if (channel % 2 == 0)
+                    expectEquals(getMaxDifference(output, channel, monoOutput, 0), 0.f, description + " isn't what a mono instance gives");
+                else
+                    expectSilent(output, channel, description + " of a silent input isn't silent");
+            }
+        }
+    }
+};
+
+static LayoutTests layoutTests;
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//headless test runner. runs every juce::UnitTest registered in the "RuckusEQ" category, prints what each one logs, and exits with 1 if any expectation failed so a build script can gate on it.
+//
+//  --category RuckusEQ     run another category instead
+//  --seed 1                seed handed to the tests' random generators, default is a new one every run
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args(argc, argv);
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    auto category = args.containsOption("--category") ? args.getValueForOption("--category") : juce::String("RuckusEQ");
+    auto seed = args.containsOption("--seed") ? args.getValueForOption("--seed").getLargeIntValue() : juce::int64(0);
+
+    runner.runTestsInCategory(category, seed);
+
+    int numTests = 0, numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+    {
+        numTests += runner.getResult(i)->passes + runner.getResult(i)->failures;
+        numFailures += runner.getResult(i)->failures;
+    }
+
+    if (runner.getNumResults() == 0)
+    {
+        std::cerr << "no tests in category " << category << std::endl;
+        return 1;
+    }
+
+    std::cout << numTests << " checks, " << numFailures << " failed" << std::endl;
+
+    return numFailures > 0 ? 1 : 0;
+}
@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    SegmentRenderTests.cpp
+    Created: 18 Oct 2026
+    Author:  acgreene
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/SegmentRender.h"
+
+//the segmented offline render against the serial one. in double precision the only difference left is what the warm-up leaves out, so that has to stay within segmentRenderErrorBound. the float render is checked for the layout of its segments on top.
+struct SegmentRenderTests : juce::UnitTest
+{
+    SegmentRenderTests() : juce::UnitTest("Segmented render", "RuckusEQ") {}
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr juce::int64 numSamples = 1 << 21;
+    static constexpr int numThreads = 8;
+
+    //the two float renders round differently after every segment boundary, by around 1e-4 of the peak level with low cut sections. a segment in the wrong place or without its warm-up is off by the size of the signal.
+    static constexpr double floatRenderBound = 1.0e-2;
+
+    //the chain's sections in double precision, with the float coefficients the chain runs from silence, transposed direct form II like the juce filters.
+    static void renderInDouble(const ChainResponse& response, const double* input, double* output, juce::int64 length)
+    {
+        std::array<std::array<double, 2>, maxChainStages> state {};
+
+        for (juce::int64 i = 0; i < length; ++i)
+        {
+            auto sample = input[i];
+
+            for (size_t stage = 0; stage < response.numStages; ++stage)
+            {
+                const auto& c = response.stages[stage];
+                auto& s = state[stage];
+
+                auto result = c[0] * sample + s[0];
+                s[0] = c[1] * sample - c[3] * result + s[1];
+                s[1] = c[2] * sample - c[4] * result;
+                sample = result;
+            }
+
+            output[i] = sample;
+        }
+    }
+
+    //noise through a one pole lowpass, so the low end that rings longest gets plenty of energy. peaks at 1.
+    static std::vector<float> makeInput(juce::Random& random)
+    {
+        std::vector<float> input(static_cast<size_t>(numSamples));
+        auto state = 0.f;
+
+        for (auto& sample : input)
+        {
+            state += 0.01f * ((random.nextFloat() * 2.f - 1.f) - state);
+            sample = juce::jlimit(-1.f, 1.f, state * 8.f);
+        }
+
+        return input;
+    }
+
+    void checkSettings(const juce::String& name, const ChainSettings& settings, juce::Random& random)
+    {
+        beginTest(name);
+
+        MonoChain chain;
+        updateMonoChain(chain, settings, sampleRate);
+
+        ChainResponse response;
+        captureResponse(chain, sampleRate, response);
+
+        auto plan = planSegments(response, 1, numSamples, numThreads);
+        expect(plan.numSegments > 1, "the stream wasn't split");
+
+        auto input = makeInput(random);
+        std::vector<double> doubleInput(input.begin(), input.end()), serial(input.size()), segmented(input.size()), segment;
+
+        renderInDouble(response, doubleInput.data(), serial.data(), numSamples);
+
+        //every segment from silence, starting warmUpLength samples early like renderSegmented does.
+        for (juce::int64 start = 0; start < numSamples; start += plan.segmentLength)
+        {
+            auto warmUp = start == 0 ? 0 : plan.warmUpLength;
+            auto length = juce::jmin(plan.segmentLength, numSamples - start);
+
+            segment.resize(static_cast<size_t>(warmUp + length));
+            renderInDouble(response, doubleInput.data() + start - warmUp, segment.data(), warmUp + length);
+            std::copy(segment.begin() + warmUp, segment.end(), segmented.begin() + start);
+        }
+
+        auto peak = 0.0, maxError = 0.0;
+
+        for (size_t i = 0; i < serial.size(); ++i)
+        {
+            peak = juce::jmax(peak, std::abs(doubleInput[i]));
+            maxError = juce::jmax(maxError, std::abs(segmented[i] - serial[i]));
+        }
+
+        maxError /= peak;
+
+        logMessage(name + ": " + juce::String(plan.numSegments) + " segments, warm-up " + juce::String(plan.warmUpLength) + " samples, double precision error " + juce::String(maxError));
+        expect(maxError <= segmentRenderErrorBound, "double precision error " + juce::String(maxError) + " above " + juce::String(segmentRenderErrorBound));
+
+        //the float render through the pool, against the same chain run serially.
+        auto floatSerial = input, floatSegmented = input;
+
+        MonoChain serialChain;
+        updateMonoChain(serialChain, settings, sampleRate);
+        serialChain.prepare({ sampleRate, static_cast<juce::uint32>(numSamples), 1 });
+
+        auto* serialSamples = floatSerial.data();
+        juce::dsp::AudioBlock<float> block(&serialSamples, 1, floatSerial.size());
+        serialChain.process(juce::dsp::ProcessContextReplacing<float>(block));
+
+        ChannelThreadPool threads;
+        threads.setNumThreads(numThreads);
+
+        auto* segmentedSamples = floatSegmented.data();
+        renderSegmented(settings, sampleRate, &segmentedSamples, 1, numSamples, threads);
+
+        auto maxFloatError = 0.0;
+
+        for (size_t i = 0; i < floatSerial.size(); ++i)
+            maxFloatError = juce::jmax(maxFloatError, static_cast<double>(std::abs(floatSegmented[i] - floatSerial[i])));
+
+        maxFloatError /= peak;
+
+        expect(maxFloatError <= floatRenderBound, "float render error " + juce::String(maxFloatError) + " above " + juce::String(floatRenderBound));
+    }
+
+    void runTest() override
+    {
+        juce::Random random(0x5e9);
+
+        checkSettings("default settings", getDefaultChainSettings(), random);
+
+        //the longest tails the parameters allow: the steepest low cut at its lowest frequency, and the narrowest band boosted right above it.
+        auto ringing = getDefaultChainSettings();
+        ringing.highPassFreq = 10.f;
+        ringing.highPassSlope = Slope::Slope_48;
+        ringing.lowPassSlope = Slope::Slope_48;
+        ringing.peaks[0].freq = peakBands[0].minFreq;
+        ringing.peaks[0].gainInDecibels = 12.f;
+        ringing.peaks[0].quality = peakBands[0].maxQuality;
+
+        checkSettings("steep low cut with a resonant low band", ringing, random);
+
+        ringing.design = CoefficientDesign::Design_Fast;
+        checkSettings("the same with the fast design", ringing, random);
+    }
+};
+
+static SegmentRenderTests segmentRenderTests;